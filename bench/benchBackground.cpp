@@ -0,0 +1,39 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+#include <glad/glad.h>
+
+#include "shapes/parallaxBackground.h"
+
+namespace {
+    // Clouds split over three layers like the Engine's background
+    void addLayers(ParallaxBackground &background, size_t clouds) {
+        background.addLayer({8.0f, 0.6f, color(1, 1, 1, 0.35f)}, clouds / 2, 270, 580, 1);
+        background.addLayer({20.0f, 0.9f, color(1, 1, 1, 0.55f)}, clouds / 3, 240, 560, 2);
+        background.addLayer({40.0f, 1.3f, color(1, 1, 1, 0.8f)}, clouds - clouds / 2 - clouds / 3,
+                            210, 540, 3);
+    }
+}
+
+// Drift and wrap pass over every cloud (no rendering)
+static void BM_ParallaxUpdate(benchmark::State &state) {
+    ParallaxBackground background(benchCloudShader(), benchWidth);
+    addLayers(background, state.range(0));
+    for (auto _ : state) {
+        background.update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallaxUpdate)->Arg(64)->Arg(4096)->Arg(65536);
+
+// Streaming positions and one instanced draw per layer
+static void BM_ParallaxDraw(benchmark::State &state) {
+    ParallaxBackground background(benchCloudShader(), benchWidth);
+    addLayers(background, state.range(0));
+    for (auto _ : state)
+        background.draw();
+    glFinish();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallaxDraw)->Arg(64)->Arg(4096);
@@ -0,0 +1,52 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+#include <glad/glad.h>
+
+#include <memory>
+#include <vector>
+
+#include "shapes/circleBatch.h"
+
+namespace {
+    const color white(1, 1, 1);
+
+    // Circles scattered over the screen, like cloud puffs or particles
+    std::vector<std::unique_ptr<Circle>> scatterCircles(size_t count) {
+        std::vector<std::unique_ptr<Circle>> circles;
+        circles.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            vec2 pos((i * 37) % benchWidth, (i * 91) % benchHeight);
+            circles.push_back(std::make_unique<Circle>(benchCircleShader(), pos, 4.0f + i % 8, white));
+        }
+        return circles;
+    }
+}
+
+// One draw call per circle, the way Cloud draws its puffs
+static void BM_CircleDrawEach(benchmark::State &state) {
+    const auto circles = scatterCircles(state.range(0));
+    for (auto _ : state) {
+        for (const auto &circle : circles) {
+            circle->setUniforms();
+            circle->draw();
+        }
+    }
+    glFinish();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircleDrawEach)->Arg(100)->Arg(1000);
+
+// Every circle in one instanced draw
+static void BM_CircleBatchDraw(benchmark::State &state) {
+    const auto circles = scatterCircles(state.range(0));
+    CircleBatch batch(benchCircleShader());
+    for (auto _ : state) {
+        for (const auto &circle : circles)
+            batch.add(*circle);
+        batch.draw();
+    }
+    glFinish();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircleBatchDraw)->Arg(100)->Arg(1000)->Arg(10000);
@@ -0,0 +1,110 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include "game/level.h"
+#include "game/levelStream.h"
+#include "shapes/circle.h"
+#include "shapes/triangle.h"
+
+namespace {
+    const color green(26 / 255.0, 176 / 255.0, 56 / 255.0);
+    const color white(1, 1, 1);
+
+    // resolvePlatformCollisions borrows the platforms, like LevelStream::getPlatforms()
+    vector<Rect *> borrow(const vector<unique_ptr<Rect>> &platforms) {
+        vector<Rect *> borrowed;
+        for (const unique_ptr<Rect> &platform : platforms)
+            borrowed.push_back(platform.get());
+        return borrowed;
+    }
+}
+
+// Single AABB test between two overlapping rects
+static void BM_RectIsOverlapping(benchmark::State &state) {
+    Rect a(benchShapeShader(), vec2(100, 100), vec2(20, 20), white);
+    Rect b(benchShapeShader(), vec2(110, 105), vec2(80, 10), green);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Rect::isOverlapping(a, b));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_RectIsOverlapping);
+
+// The play-state collision loop from Engine::updatePlatforming against the first screen of a
+// streamed level, as loaded when a game starts
+static void BM_PlayCollisionLoop(benchmark::State &state) {
+    JobSystem jobs(2);
+    LevelStream levels(jobs, benchShapeShader(), green, benchWidth, benchHeight, 10.0f);
+    levels.reset(1);
+    levels.update(0.0f, benchHeight);
+    levels.finish();
+    const vector<Rect *> &platforms = levels.getPlatforms();
+
+    // Player falling onto the ground platform
+    const vec2 currentPos(benchWidth / 2, 112);
+    Rect nextPosRect(benchShapeShader(), vec2(benchWidth / 2, 108), vec2(20, 20), white);
+    for (auto _ : state) {
+        vec2 nextPos = nextPosRect.getPos();
+        vec2 velocity(0, -300);
+        benchmark::DoNotOptimize(resolvePlatformCollisions(platforms, currentPos, nextPosRect,
+                                                           nextPos, velocity));
+        benchmark::DoNotOptimize(nextPos);
+    }
+    state.counters["platforms"] = platforms.size();
+}
+BENCHMARK(BM_PlayCollisionLoop);
+
+// Same loop with an artificially large number of platforms, to see how it scales with level size
+static void BM_PlayCollisionLoopScaling(benchmark::State &state) {
+    srand(1);
+    vector<unique_ptr<Rect>> platforms;
+    for (int i = 0; i < state.range(0); ++i) {
+        platforms.push_back(std::make_unique<Rect>(
+            benchShapeShader(), vec2(rand() % benchWidth, rand() % benchHeight),
+            vec2(rand() % 100 + 80, 10), green));
+    }
+    const vector<Rect *> borrowed = borrow(platforms);
+    const vec2 currentPos(benchWidth / 2, benchHeight / 2 + 4);
+    Rect nextPosRect(benchShapeShader(), vec2(benchWidth / 2, benchHeight / 2), vec2(20, 20), white);
+    for (auto _ : state) {
+        vec2 nextPos = nextPosRect.getPos();
+        vec2 velocity(0, -300);
+        benchmark::DoNotOptimize(resolvePlatformCollisions(borrowed, currentPos, nextPosRect,
+                                                           nextPos, velocity));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PlayCollisionLoopScaling)->RangeMultiplier(8)->Range(8, 4096);
+
+// The player against a mix of rects, circles and triangles through Shape::isOverlapping (the
+// ShapeKind dispatch table)
+static void BM_MixedShapeOverlap(benchmark::State &state) {
+    srand(1);
+    vector<unique_ptr<Shape>> hazards;
+    for (int i = 0; i < state.range(0); ++i) {
+        vec2 pos(rand() % benchWidth, rand() % benchHeight);
+        switch (i % 3) {
+            case 0:
+                hazards.push_back(std::make_unique<Rect>(benchShapeShader(), pos, vec2(40, 10), green));
+                break;
+            case 1:
+                hazards.push_back(std::make_unique<Circle>(benchCircleShader(), pos, 12.0f, white));
+                break;
+            default:
+                hazards.push_back(std::make_unique<Triangle>(benchShapeShader(), pos, vec2(20, 20), white));
+                break;
+        }
+    }
+    Rect player(benchShapeShader(), vec2(benchWidth / 2, benchHeight / 2), vec2(20, 20), white);
+    for (auto _ : state) {
+        int hits = 0;
+        for (const unique_ptr<Shape> &hazard : hazards)
+            hits += player.isOverlapping(*hazard);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedShapeOverlap)->Arg(64)->Arg(1024);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "game/battleLog.h"
+#include "game/combatRandom.h"
+#include "game/combatRegistry.h"
+
+namespace {
+    // Every creature in the game, repeated up to count combatants
+    std::vector<entityInfo> creatureRows(size_t count) {
+        static const std::vector<entityInfo> creatures =
+            loadEntityInfo("entity-data/enemy_creatureinfo.csv");
+        std::vector<entityInfo> rows;
+        for (size_t i = 0; i < count && !creatures.empty(); ++i)
+            rows.push_back(creatures[i % creatures.size()]);
+        return rows;
+    }
+}
+
+// One enemy turn for a crowd of creatures stored as components: the multi-enemy battle workload.
+static void BM_CombatRegistryEnemyTurns(benchmark::State &state) {
+    seedCombatRandom(1);
+    CombatRegistry registry;
+    const std::vector<entityInfo> rows = creatureRows(static_cast<size_t>(state.range(0)));
+    registry.reserve(rows.size() + 1);
+    for (const entityInfo &row : rows)
+        registry.spawn(row, CombatSide::Enemy);
+    const CombatantId target =
+        registry.spawn({"Player", "A lone knight.", 1e9f, 0, 1}, CombatSide::Player);
+
+    BattleLog log;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runEnemyTurns(registry, target, log));
+        registry.status.get(target).value = combatStatus::None;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rows.size()));
+}
+BENCHMARK(BM_CombatRegistryEnemyTurns)->RangeMultiplier(4)->Range(64, 16384);
+
+// Engine's goal transition: the beaten enemy leaves the registry and the next one is spawned.
+static void BM_CombatRegistryEncounterSwap(benchmark::State &state) {
+    CombatRegistry registry;
+    const std::vector<entityInfo> rows = creatureRows(64);
+    for (const entityInfo &row : rows)
+        registry.internName(row.name, row.description);
+    registry.spawn({"Player", "A lone knight.", 100, 0, 1}, CombatSide::Player);
+    CombatantId opponent = registry.spawn(rows.front(), CombatSide::Enemy);
+    size_t next = 1;
+    for (auto _ : state) {
+        registry.destroy(opponent);
+        opponent = registry.spawn(rows[next++ % rows.size()], CombatSide::Enemy);
+        benchmark::DoNotOptimize(opponent);
+    }
+}
+BENCHMARK(BM_CombatRegistryEncounterSwap);
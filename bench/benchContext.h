@@ -0,0 +1,38 @@
+#ifndef RUNNER_BENCH_CONTEXT_H
+#define RUNNER_BENCH_CONTEXT_H
+
+#include "shader/shader.h"
+
+/*
+ * GL context and shaders shared by every benchmark in runner_bench. Created once in benchMain.cpp
+ * before any benchmark runs, on a surfaceless EGL context rendering into a Framebuffer, so the
+ * suite runs on headless hosts. Set LIBGL_ALWAYS_SOFTWARE=1 to force Mesa's llvmpipe for numbers
+ * that don't depend on the machine's GPU.
+ */
+
+/// @brief Creates the GL context and loads the shape/text/circle/cloud/sprite shaders.
+/// @return false if no context could be created.
+bool initBenchContext();
+
+/// @brief Destroys the context created by initBenchContext().
+void shutdownBenchContext();
+
+/// @brief Shader used for shapes (shape.vert/shape.frag) with the engine's projection set.
+Shader &benchShapeShader();
+
+/// @brief Shader used for text (text.vert/text.frag).
+Shader &benchTextShader();
+
+/// @brief Shader used for circles (circle.vert/circle.frag) with the engine's projection set.
+Shader &benchCircleShader();
+
+/// @brief Shader used for background clouds (cloud.vert/cloud.frag) with the engine's projection set.
+Shader &benchCloudShader();
+
+/// @brief Shader used for sprites (sprite.vert/sprite.frag) with the engine's projection set.
+Shader &benchSpriteShader();
+
+/// @brief Same window size as Engine.
+constexpr unsigned int benchWidth = 800, benchHeight = 600;
+
+#endif //RUNNER_BENCH_CONTEXT_H
@@ -0,0 +1,83 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+#include "game/level.h"
+#include "util/jobSystem.h"
+
+/*
+ * Job system scaling: each benchmark takes the number of threads doing work (workers plus the
+ * waiting thread) as its argument, from 1 up to the machine's hardware threads. Compare
+ * items_per_second across arguments; real time is used since the work happens off the timing
+ * thread.
+ */
+namespace {
+    const color green(26 / 255.0, 176 / 255.0, 56 / 255.0);
+
+    void threadCounts(benchmark::internal::Benchmark *benchmark) {
+        const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int threads = 1; threads <= cores; threads *= 2)
+            benchmark->Arg(threads);
+        if ((cores & (cores - 1)) != 0)
+            benchmark->Arg(cores);
+    }
+}
+
+// Scheduling overhead: tiny jobs that do no work
+static void BM_JobSystemEmptyJobs(benchmark::State &state) {
+    JobSystem jobs(static_cast<unsigned int>(state.range(0) - 1));
+    const int jobCount = 1024;
+    for (auto _ : state) {
+        JobFence fence;
+        for (int i = 0; i < jobCount; ++i)
+            jobs.run(fence, [] {});
+        jobs.wait(fence);
+    }
+    state.SetItemsProcessed(state.iterations() * jobCount);
+}
+BENCHMARK(BM_JobSystemEmptyJobs)->Apply(threadCounts)->UseRealTime();
+
+// Batch collision: many boxes (e.g. roaming enemies) against a large level
+static void BM_JobSystemBatchCollision(benchmark::State &state) {
+    JobSystem jobs(static_cast<unsigned int>(state.range(0) - 1));
+    srand(1);
+    vector<unique_ptr<Rect>> platforms;
+    for (int i = 0; i < 512; ++i) {
+        platforms.push_back(std::make_unique<Rect>(
+            benchShapeShader(), vec2(rand() % benchWidth, rand() % (benchHeight * 8)),
+            vec2(rand() % 100 + 80, 10), green));
+    }
+    vector<CollisionBox> queries;
+    for (int i = 0; i < 16384; ++i)
+        queries.push_back({vec2(rand() % benchWidth, rand() % (benchHeight * 8)), vec2(20, 20)});
+
+    vector<int> firstHit;
+    for (auto _ : state) {
+        queryPlatformOverlaps(jobs, platforms, queries, firstHit);
+        benchmark::DoNotOptimize(firstHit.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+BENCHMARK(BM_JobSystemBatchCollision)->Apply(threadCounts)->UseRealTime();
+
+// Level generation: laying out a batch of chunks in parallel, as LevelStream does a few at a time
+static void BM_JobSystemLevelLayouts(benchmark::State &state) {
+    JobSystem jobs(static_cast<unsigned int>(state.range(0) - 1));
+    const size_t chunkCount = 1024;
+    vector<ChunkLayout> chunks(chunkCount);
+    for (auto _ : state) {
+        JobFence fence;
+        jobs.parallelFor(fence, chunkCount, 16, [&](size_t begin, size_t end) {
+            for (size_t index = begin; index < end; ++index)
+                layoutChunk(chunks[index], benchWidth, index, benchHeight, 10.0f, 1);
+        });
+        jobs.wait(fence);
+        benchmark::DoNotOptimize(chunks.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(chunkCount));
+}
+BENCHMARK(BM_JobSystemLevelLayouts)->Apply(threadCounts)->UseRealTime();
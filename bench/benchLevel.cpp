@@ -0,0 +1,120 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+#include <glad/glad.h>
+
+#include <algorithm>
+
+#include "game/levelStream.h"
+#include "render/camera.h"
+#include "util/metrics.h"
+
+namespace {
+    const color green(26 / 255.0, 176 / 255.0, 56 / 255.0);
+}
+
+// A new level as Engine::initShapes makes it: reset the stream, lay out and build the first
+// screen and find its goal. The stream is kept between iterations like the Engine's, so platforms
+// come out of its pool, which is what a reset after the first game pays for.
+static void BM_LevelStreamReset(benchmark::State &state) {
+    JobSystem jobs(2);
+    LevelStream levels(jobs, benchShapeShader(), green, benchWidth, benchHeight, 10.0f);
+    unsigned int seed = 1;
+    vec2 goal;
+    for (auto _ : state) {
+        levels.reset(seed++);
+        levels.update(0.0f, benchHeight);
+        levels.finish();
+        benchmark::DoNotOptimize(levels.findGoal(0, goal));
+    }
+    state.counters["platforms"] = levels.getPlatforms().size();
+}
+BENCHMARK(BM_LevelStreamReset);
+
+// Drawing a level range(0) screens tall from halfway up, everything (range(1) == 0) or only what
+// the camera sees (range(1) == 1)
+static void BM_DrawTallLevel(benchmark::State &state) {
+    const float levelHeight = benchHeight * static_cast<float>(state.range(0));
+    JobSystem jobs(2);
+    LevelStream levels(jobs, benchShapeShader(), green, benchWidth, benchHeight, 10.0f);
+    levels.reset(1);
+    levels.update(0.0f, levelHeight);
+    levels.finish();
+    const vector<Rect *> &platforms = levels.getPlatforms();
+    Camera camera(benchWidth, benchHeight);
+    camera.setVerticalLimits(0.0f, levelHeight);
+    camera.setPosition(vec2(benchWidth / 2, levelHeight / 2));
+    const bool cull = state.range(1) != 0;
+    vector<const Rect *> visible;
+    benchShapeShader().use();
+    benchShapeShader().setMatrix4("projection", camera.getViewProjection());
+    for (auto _ : state) {
+        if (cull) {
+            camera.cull(platforms, visible);
+        }
+        else {
+            visible.assign(platforms.begin(), platforms.end());
+        }
+        for (const Rect *platform : visible) {
+            platform->setUniforms();
+            platform->draw();
+        }
+    }
+    glFinish();
+    // A camera that hasn't moved sees the screen, like the projection other benchmarks expect
+    benchShapeShader().setMatrix4("projection", Camera(benchWidth, benchHeight).getViewProjection());
+    state.counters["drawn"] = visible.size();
+    state.counters["platforms"] = platforms.size();
+}
+BENCHMARK(BM_DrawTallLevel)->Args({1, 0})->Args({1, 1})->Args({20, 0})->Args({20, 1});
+
+// Streaming a climb of range(0) screens, a tenth of a screen per frame like a fast player. The
+// peak number of loaded platforms should be the same for a short climb and a long one.
+static void BM_LevelStreamClimb(benchmark::State &state) {
+    JobSystem jobs(2);
+    const size_t screens = static_cast<size_t>(state.range(0));
+    size_t peakPlatforms = 0;
+    for (auto _ : state) {
+        LevelStream levels(jobs, benchShapeShader(), green, benchWidth, benchHeight, 10.0f);
+        levels.reset(1);
+        for (size_t frame = 0; frame < screens * 10; ++frame) {
+            const float bottom = frame * benchHeight / 10.0f;
+            levels.update(bottom, bottom + benchHeight);
+            peakPlatforms = std::max(peakPlatforms, levels.getPlatforms().size());
+        }
+        levels.finish();
+    }
+    state.counters["peakPlatforms"] = peakPlatforms;
+    state.SetItemsProcessed(state.iterations() * screens * 10);
+}
+BENCHMARK(BM_LevelStreamClimb)->Arg(10)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// Heap allocations per frame of a climb once the stream's pools have warmed up (one climb, then
+// the same climb again after a reset, like a new game). Counted only with RUNNER_COUNT_ALLOCATIONS;
+// platforms and chunks come back out of their pools and layout jobs go into the job queues' ring
+// buffers, so this should stay at 0.
+static void BM_LevelStreamSteadyAllocations(benchmark::State &state) {
+    JobSystem jobs(2);
+    LevelStream levels(jobs, benchShapeShader(), green, benchWidth, benchHeight, 10.0f);
+    const size_t frames = 100;
+    auto climb = [&] {
+        for (size_t frame = 0; frame < frames; ++frame) {
+            const float bottom = frame * benchHeight / 10.0f;
+            levels.update(bottom, bottom + benchHeight);
+        }
+        levels.finish();
+    };
+    levels.reset(1);
+    climb();
+    uint64_t allocations = 0;
+    for (auto _ : state) {
+        levels.reset(1);
+        Metrics::endFrame(0.0f);
+        climb();
+        Metrics::endFrame(0.0f);
+        allocations += Metrics::lastFrame(Metric::HeapAllocations);
+    }
+    state.counters["allocsPerFrame"] = static_cast<double>(allocations) / (state.iterations() * frames);
+    state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(BM_LevelStreamSteadyAllocations)->Unit(benchmark::kMillisecond);
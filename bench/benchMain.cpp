@@ -0,0 +1,118 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <iostream>
+#include <memory>
+
+#include "render/framebuffer.h"
+#include "render/offscreenContext.h"
+#include "render/streamBuffer.h"
+#include "shader/shaderManager.h"
+#include "shapes/circleBatch.h"
+
+namespace {
+    OffscreenContext offscreenContext;
+    GLFWwindow *window = nullptr;
+    std::unique_ptr<Framebuffer> target;
+    std::unique_ptr<ShaderManager> shaderManager;
+    Shader shapeShader;
+    Shader textShader;
+    Shader circleShader;
+    Shader cloudShader;
+    Shader spriteShader;
+}
+
+bool initBenchContext() {
+    // Same backend selection as Engine's offscreen mode: surfaceless EGL first, then a hidden
+    // GLFW window. Nothing is presented either way.
+    if (offscreenContext.create()) {
+        if (!gladLoadGLLoader((GLADloadproc)OffscreenContext::getProcAddress))
+            return false;
+    } else {
+        if (!glfwInit())
+            return false;
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(benchWidth, benchHeight, "runner_bench", nullptr, nullptr);
+        if (!window)
+            return false;
+        glfwMakeContextCurrent(window);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+            return false;
+    }
+    target = std::make_unique<Framebuffer>(benchWidth, benchHeight);
+    target->bind();
+
+    glViewport(0, 0, benchWidth, benchHeight);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    shaderManager = std::make_unique<ShaderManager>();
+    shapeShader = shaderManager->loadShader("../res/shaders/shape.vert", "../res/shaders/shape.frag",
+                                            nullptr, "shape");
+    shapeShader.use();
+    shapeShader.setMatrix4("projection", glm::ortho(0.0f, (float)benchWidth, 0.0f,
+                                                    (float)benchHeight, -1.0f, 1.0f));
+    textShader = shaderManager->loadShader("../res/shaders/text.vert", "../res/shaders/text.frag",
+                                           nullptr, "text");
+    circleShader = shaderManager->loadShader("../res/shaders/circle.vert",
+                                             "../res/shaders/circle.frag", nullptr, "circle");
+    circleShader.use();
+    circleShader.setMatrix4("projection", glm::ortho(0.0f, (float)benchWidth, 0.0f,
+                                                     (float)benchHeight, -1.0f, 1.0f));
+    cloudShader = shaderManager->loadShader("../res/shaders/cloud.vert",
+                                            "../res/shaders/cloud.frag", nullptr, "cloud");
+    cloudShader.use();
+    cloudShader.setMatrix4("projection", glm::ortho(0.0f, (float)benchWidth, 0.0f,
+                                                    (float)benchHeight, -1.0f, 1.0f));
+    spriteShader = shaderManager->loadShader("../res/shaders/sprite.vert",
+                                             "../res/shaders/sprite.frag", nullptr, "sprite");
+    spriteShader.use();
+    spriteShader.setMatrix4("projection", glm::ortho(0.0f, (float)benchWidth, 0.0f,
+                                                     (float)benchHeight, -1.0f, 1.0f));
+    spriteShader.setInteger("image", 0);
+    return true;
+}
+
+void shutdownBenchContext() {
+    CircleBatch::releaseShared();
+    StreamBuffer::releaseShared();
+    shaderManager.reset();
+    target.reset();
+    if (window) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+    offscreenContext.destroy();
+}
+
+Shader &benchShapeShader() { return shapeShader; }
+
+Shader &benchTextShader() { return textShader; }
+
+Shader &benchCircleShader() { return circleShader; }
+
+Shader &benchCloudShader() { return cloudShader; }
+
+Shader &benchSpriteShader() { return spriteShader; }
+
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    if (!initBenchContext()) {
+        std::cout << "ERROR::BENCH: Could not create a GL context" << std::endl;
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    shutdownBenchContext();
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+#include <glad/glad.h>
+
+#include <random>
+#include <vector>
+
+#include "render/textureAtlas.h"
+#include "shapes/spriteBatch.h"
+
+namespace {
+    // 16x16 pixel art tiles in a checker pattern of two colors
+    std::vector<unsigned char> tile(unsigned char shade) {
+        std::vector<unsigned char> pixels(16 * 16 * 4);
+        for (size_t i = 0; i < 16 * 16; ++i) {
+            const bool dark = ((i % 16) / 4 + (i / 16) / 4) % 2;
+            pixels[i * 4 + 0] = dark ? shade / 2 : shade;
+            pixels[i * 4 + 1] = dark ? 64 : 192;
+            pixels[i * 4 + 2] = 255 - shade;
+            pixels[i * 4 + 3] = 255;
+        }
+        return pixels;
+    }
+}
+
+// Packing a page's worth of mixed size images (fonts and sprite sheets)
+static void BM_SkylinePack(benchmark::State &state) {
+    std::minstd_rand random(1);
+    std::uniform_int_distribution<int> side(4, 48);
+    std::vector<std::pair<int, int>> sizes(state.range(0));
+    for (auto &size : sizes)
+        size = {side(random), side(random)};
+    SkylinePacker packer(1024, 1024);
+    for (auto _ : state) {
+        packer.clear();
+        int x, y;
+        for (const auto &size : sizes)
+            benchmark::DoNotOptimize(packer.insert(size.first, size.second, x, y));
+    }
+    state.counters["occupancy"] = packer.occupancy();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SkylinePack)->Arg(100)->Arg(1000);
+
+// Sprites from 64 tiles spread over two small atlas pages, so draw() sorts into two draws
+static void BM_SpriteBatchDraw(benchmark::State &state) {
+    TextureAtlas atlas(128);
+    std::vector<AtlasRegion> regions;
+    for (int i = 0; i < 64; ++i)
+        regions.push_back(atlas.add(tile(static_cast<unsigned char>(i * 4)).data(), 16, 16));
+    std::vector<Sprite> scattered;
+    for (size_t i = 0; i < static_cast<size_t>(state.range(0)); ++i) {
+        scattered.emplace_back(regions[i % regions.size()],
+                               vec2((i * 37) % benchWidth, (i * 91) % benchHeight));
+        scattered.back().setRotation(0.01f * (i % 100));
+    }
+    SpriteBatch batch(benchSpriteShader(), atlas);
+    for (auto _ : state) {
+        for (const Sprite &sprite : scattered)
+            batch.add(sprite);
+        batch.draw();
+    }
+    glFinish();
+    state.counters["pages"] = atlas.getPageCount();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpriteBatchDraw)->Arg(1000)->Arg(10000)->Arg(50000);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "game/combatRandom.h"
+#include "game/gameStateMachine.h"
+
+// Headless battles through the game state machine: no view, so this is the cost of the table
+// lookups plus the combat actions and their messages. Each iteration is one key press
+// (Attack or Confirm), items processed counts player turns.
+static void BM_StateMachineBattleTurns(benchmark::State &state) {
+    seedCombatRandom(1);
+    CombatRegistry combatants;
+    GameSession session;
+    session.combatants = &combatants;
+    session.player = combatants.spawn({"Player", "A lone knight.", 100, 0, 1}, CombatSide::Player);
+    // A mid-table creature from enemy_creatureinfo.csv
+    session.opponent = combatants.spawn(
+        {"Hobgoblin Brute", "A larger and more disciplined goblin wielding a heavy club", 60, 90, -1},
+        CombatSide::Enemy);
+    Health &opponentHealth = combatants.health.get(session.opponent);
+    GameStateMachine game(gameStateTable(), GameState::Start);
+    game.start(session);
+    game.dispatch(GameEvent::Confirm, session);
+
+    for (auto _ : state) {
+        switch (game.getState()) {
+        case GameState::Play:
+            // Next battle against a fresh copy of the same enemy
+            opponentHealth.current = opponentHealth.base;
+            game.dispatch(GameEvent::GoalReached, session);
+            break;
+        case GameState::Over:
+            game.dispatch(GameEvent::Restart, session);
+            game.dispatch(GameEvent::Confirm, session);
+            break;
+        case GameState::PlayerTurn:
+            game.dispatch(GameEvent::Attack, session);
+            break;
+        default:
+            game.dispatch(GameEvent::Confirm, session);
+            break;
+        }
+        benchmark::DoNotOptimize(session.message.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(session.turns));
+}
+BENCHMARK(BM_StateMachineBattleTurns);
+
+// A dispatch the current state has no transition for (e.g. Attack while platforming): the
+// cost every unbound key press pays.
+static void BM_StateMachineIgnoredEvent(benchmark::State &state) {
+    GameSession session;
+    GameStateMachine game(gameStateTable(), GameState::Play);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(game.dispatch(GameEvent::Attack, session));
+}
+BENCHMARK(BM_StateMachineIgnoredEvent);
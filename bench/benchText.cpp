@@ -0,0 +1,73 @@
+#include "benchContext.h"
+
+#include <benchmark/benchmark.h>
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "font/fontRenderer.h"
+#include "shapes/textbox.h"
+#include "util/frameArena.h"
+
+namespace {
+    const char *fontPath = "../res/fonts/MxPlus_IBM_BIOS.ttf";
+    const std::string battleText =
+        "Goblin Scout is attacking!\nGoblin Scout Attacks!\n10 damage!\n(A)ttack.\n(D)efend.";
+    const glm::mat4 projection = glm::ortho(0.0f, (float)benchWidth, 0.0f, (float)benchHeight,
+                                            -1.0f, 1.0f);
+}
+
+// Wrapping and glyph placement for a full battle message (no rendering)
+static void BM_TextboxLayout(benchmark::State &state) {
+    Textbox textbox(benchShapeShader(), benchTextShader(), vec2(benchWidth / 2, benchHeight / 5),
+                    vec2(400, 100), color(0, 0, 0), fontPath);
+    textbox.setProjection(projection);
+    textbox.disableScrolling();
+    for (auto _ : state) {
+        textbox.setText(battleText);
+        benchmark::DoNotOptimize(textbox.layout(0.016f));
+        FrameArena::frame().reset();
+    }
+    state.counters["glyphs"] = textbox.getLayoutGlyphs().size();
+}
+BENCHMARK(BM_TextboxLayout);
+
+// Copies of a battle message thrown away within a frame, on the heap (range(0) == 0) or in the
+// frame arena (range(0) == 1)
+template <typename String>
+static void transientStrings(benchmark::State &state) {
+    for (auto _ : state) {
+        for (int i = 0; i < 16; ++i) {
+            String copy(battleText.data(), battleText.size());
+            benchmark::DoNotOptimize(copy.data());
+        }
+        FrameArena::frame().reset();
+    }
+}
+static void BM_TransientStrings(benchmark::State &state) {
+    if (state.range(0) == 0)
+        transientStrings<std::string>(state);
+    else
+        transientStrings<ArenaString>(state);
+}
+BENCHMARK(BM_TransientStrings)->Arg(0)->Arg(1);
+
+// One glyph per call, which is how Textbox::draw drives the renderer
+static void BM_FontRendererRenderGlyph(benchmark::State &state) {
+    FontRenderer renderer(benchTextShader(), fontPath, 24);
+    const std::string glyph = "A";
+    for (auto _ : state)
+        renderer.renderText(glyph, 100.0f, 100.0f, projection, 1.0f, glm::vec3(1.0f));
+    glFinish();
+}
+BENCHMARK(BM_FontRendererRenderGlyph);
+
+// A whole line of text in one call
+static void BM_FontRendererRenderLine(benchmark::State &state) {
+    FontRenderer renderer(benchTextShader(), fontPath, 24);
+    const std::string line = "You have encountered a Goblin Scout";
+    for (auto _ : state)
+        renderer.renderText(line, 20.0f, 300.0f, projection, 1.0f, glm::vec3(1.0f));
+    glFinish();
+    state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_FontRendererRenderLine);
@@ -1,22 +1,17 @@
 #version 330 core
-in vec2 FragPos;
+in vec2 LocalPos;
+in float Radius;
+in vec4 CircleColor;
 out vec4 FragColor;
 
-uniform vec3 Color;
-uniform vec2 CircleCenter;
-uniform float Radius;
-
 void main()
 {
-    // Calculate the distance from the center of the circle to the fragment
-    float distance = length(FragPos - CircleCenter);
-
-    // If the distance is greater than the radius of the circle, discard the fragment
-    if (distance > Radius)
-    {
+    // Signed distance to the circle's edge (negative inside)
+    float distance = length(LocalPos) - Radius;
+    // Fade over one pixel across the edge instead of discarding
+    float pixel = max(fwidth(distance), 0.0001);
+    float coverage = clamp(0.5 - distance / pixel, 0.0, 1.0);
+    if (coverage <= 0.0)
         discard;
-    }
-
-    // If fragment is inside the circle, color it
-    FragColor = vec4(Color, 1.0f);
+    FragColor = vec4(CircleColor.rgb, CircleColor.a * coverage);
 }
@@ -0,0 +1,21 @@
+#version 330 core
+// Circles are quads: one shared unit quad, stretched over each circle by its instance attributes
+layout (location = 0) in vec2 corner;   // <-1..1, -1..1>
+layout (location = 1) in vec2 center;   // per instance
+layout (location = 2) in float radius;  // per instance
+layout (location = 3) in vec4 color;    // per instance
+
+out vec2 LocalPos;
+out float Radius;
+out vec4 CircleColor;
+
+uniform mat4 projection;
+
+void main()
+{
+    // One unit of margin so the anti-aliased edge isn't clipped by the quad
+    LocalPos = corner * (radius + 1.0);
+    Radius = radius;
+    CircleColor = color;
+    gl_Position = projection * vec4(center + LocalPos, 0.0, 1.0);
+}
@@ -0,0 +1,31 @@
+#version 330 core
+in vec2 LocalPos;
+out vec4 FragColor;
+
+uniform vec4 cloudColor;
+
+float circleDistance(vec2 p, vec2 center, float radius)
+{
+    return length(p - center) - radius;
+}
+
+float boxDistance(vec2 p, vec2 halfSize)
+{
+    vec2 d = abs(p) - halfSize;
+    return length(max(d, 0.0)) + min(max(d.x, d.y), 0.0);
+}
+
+void main()
+{
+    // Same layout as Cloud: a 15x15 body and three puffs 25 across
+    float distance = boxDistance(LocalPos, vec2(7.5));
+    distance = min(distance, circleDistance(LocalPos, vec2(3.0, 15.0), 12.5));
+    distance = min(distance, circleDistance(LocalPos, vec2(-10.0, 5.0), 12.5));
+    distance = min(distance, circleDistance(LocalPos, vec2(10.0, 5.0), 12.5));
+
+    float pixel = max(fwidth(distance), 0.0001);
+    float coverage = clamp(0.5 - distance / pixel, 0.0, 1.0);
+    if (coverage <= 0.0)
+        discard;
+    FragColor = vec4(cloudColor.rgb, cloudColor.a * coverage);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+// Clouds are instanced quads covering a Cloud's puffs and body; positions come from
+// ParallaxBackground's per-layer arrays
+layout (location = 0) in vec2 corner;   // <-1..1, -1..1>
+layout (location = 1) in float cloudX;  // per instance
+layout (location = 2) in float cloudY;  // per instance
+
+out vec2 LocalPos;
+
+uniform mat4 projection;
+uniform float scale;
+
+// Bounds of the cloud shape in cloud.frag, plus a unit of margin for the anti-aliased edge
+const vec2 boundsCenter = vec2(0.0, 10.0);
+const vec2 boundsHalf = vec2(23.5, 18.5);
+
+void main()
+{
+    LocalPos = boundsCenter + corner * boundsHalf;
+    gl_Position = projection * vec4(vec2(cloudX, cloudY) + LocalPos * scale, 0.0, 1.0);
+}
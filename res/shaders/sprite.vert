@@ -1,14 +1,25 @@
 #version 330 core
-// Both position and texture coordinates contain two floats, so we combine them into a single vertex attribute
-layout (location = 0) in vec4 vertex; // <vec2 position, vec2 texCoords>
+// Sprites are quads: one shared unit quad, placed, rotated and textured by its instance attributes
+layout (location = 0) in vec2 corner;    // <-1..1, -1..1>
+layout (location = 1) in vec2 center;    // per instance
+layout (location = 2) in vec2 halfSize;  // per instance
+layout (location = 3) in float rotation; // per instance, radians counterclockwise
+layout (location = 4) in vec4 uvRect;    // per instance, <u0, v0, u1, v1> of the top left and bottom right
+layout (location = 5) in vec4 tint;      // per instance
 
 out vec2 TexCoords;
+out vec4 SpriteTint;
 
-uniform mat4 model;
 uniform mat4 projection;
 
 void main()
 {
-    TexCoords = vertex.zw;
-    gl_Position = projection * model * vec4(vertex.xy, 0.0, 1.0);
-}
\ No newline at end of file
+    vec2 local = corner * halfSize;
+    float s = sin(rotation);
+    float c = cos(rotation);
+    vec2 rotated = vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+    // Atlas images are stored top row first, so the top of the quad samples v0
+    TexCoords = mix(uvRect.xy, uvRect.zw, vec2(corner.x, -corner.y) * 0.5 + 0.5);
+    SpriteTint = tint;
+    gl_Position = projection * vec4(center + rotated, 0.0, 1.0);
+}
@@ -1,13 +1,17 @@
 #include "engine.h"
+#include "game/combatRandom.h"
+#include "game/level.h"
 #include "game/player.h"
+#include "render/streamBuffer.h"
+#include "shapes/circleBatch.h"
+#include "util/metrics.h"
+#include "util/profiler.h"
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <random>
 using namespace std;
 
-// enums for screen state control, modeled after m4gp confetti
-enum state { start, play, battle, over };
-state screen = start;
-
 // const colors
 const color blue(77 / 255.0, 213 / 255.0, 240 / 255.0);
 const color green(26 / 255.0, 176 / 255.0, 56 / 255.0);
@@ -15,27 +19,107 @@ const color white(1, 1, 1);
 const color black(0, 0, 0);
 const color red(1, 0, 0);
 
+// Time render() spends on asset uploads each frame, so loading fonts doesn't
+// hitch the frame
+const double assetUploadBudget = 0.002;
+// Glyph textures created per upload step (checked against the budget between
+// steps)
+const size_t glyphsPerUploadStep = 16;
+
 // storing this as a global variable instead of a private member of engine,
 // gave parameter problems otherwise
 vec2 playerVelocity(0, 0);
 
 // Engine constructor initializes the window, shaders and relative shapes (to be
 // drawn) akin to other module 4 projects
-Engine::Engine() : keys()
+Engine::Engine(const EngineConfig &config)
+    : config(config), keys(), keysHandled()
 {
   this->initWindow();
   this->initShaders();
+
+  // Offscreen runs must render the same frames every time, so they don't
+  // start until every asset is in (including the creature table, whose upload
+  // spawns the first enemy), and battles roll the same dice. Levels and
+  // enemies come from rand(), which starts from the same seed anyway
+  if (config.offscreen)
+  {
+    assets.finish();
+    seedCombatRandom(1);
+  }
+
+  if (config.autoplay)
+    climber = make_unique<Climber>(moveSpeed, jumpForce, gravity);
+
   this->initShapes();
 
+  if (config.targetFps > 0)
+    frameLimiter = make_unique<FrameLimiter>(config.targetFps);
+
   // Also intitializes the player:
-  playerCharacter = make_unique<entity>(100, 0, "Player", "A lone knight.", 1);
+  session.combatants = &combatants;
+  session.player = combatants.spawn({"Player", "A lone knight.", 100, 0, 1},
+				    CombatSide::Player);
+
+  // Start the game flow on the welcome screen
+  session.view = this;
+  game.start(session);
 }
 
 // Destructor
-Engine::~Engine() {}
+Engine::~Engine()
+{
+  Profiler::releaseGpuTimers();
+  CircleBatch::releaseShared();
+  StreamBuffer::releaseShared();
+}
 
 unsigned int Engine::initWindow(bool debug)
 {
+  if (config.offscreen)
+  {
+    // Prefer a surfaceless EGL context; fall back to a hidden GLFW window if
+    // EGL isn't available. Either way we draw into our own framebuffer.
+    offscreenContext = make_unique<OffscreenContext>();
+    if (offscreenContext->create())
+    {
+      if (!gladLoadGLLoader((GLADloadproc)OffscreenContext::getProcAddress))
+      {
+	cout << "Failed to initialize GLAD" << endl;
+	return -1;
+      }
+    }
+    else
+    {
+      offscreenContext.reset();
+      glfwInit();
+      glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+      glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+      glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+      glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+      window = glfwCreateWindow(width, height, "engine", nullptr, nullptr);
+      glfwMakeContextCurrent(window);
+      if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+      {
+	cout << "Failed to initialize GLAD" << endl;
+	return -1;
+      }
+    }
+
+    offscreenTarget = make_unique<Framebuffer>(width, height);
+    if (!offscreenTarget->isComplete())
+    {
+      cout << "Offscreen framebuffer is incomplete" << endl;
+      return -1;
+    }
+    offscreenTarget->bind();
+
+    glViewport(0, 0, width, height);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    return 0;
+  }
+
   // glfw: initialize and configure
   glfwInit();
   glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -62,15 +146,45 @@ unsigned int Engine::initWindow(bool debug)
   glViewport(0, 0, width, height);
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glfwSwapInterval(1);
+  applyPresentMode();
 
   return 0;
 }
 
+void Engine::applyPresentMode()
+{
+  switch (config.presentMode)
+  {
+  case PresentMode::VSync:
+    glfwSwapInterval(1);
+    break;
+  case PresentMode::Immediate:
+    glfwSwapInterval(0);
+    break;
+  case PresentMode::Adaptive:
+    // Negative intervals need the swap_control_tear extension
+    if (glfwExtensionSupported("GLX_EXT_swap_control_tear") ||
+	glfwExtensionSupported("WGL_EXT_swap_control_tear"))
+      glfwSwapInterval(-1);
+    else
+    {
+      cout << "Adaptive vsync is not supported, using vsync" << endl;
+      glfwSwapInterval(1);
+    }
+    break;
+  }
+}
+
 void Engine::initShaders()
 {
-  // load shader manager
-  shaderManager = make_unique<ShaderManager>();
+  // load shader manager (programs linked by an earlier run load from its
+  // cache instead of compiling)
+  shaderManager = make_unique<ShaderManager>(config.shaderCacheDir);
+  if (config.hotReloadShaders && !config.offscreen)
+    shaderManager->enableHotReload(
+	[this](const string &name, Shader &shader) {
+	  shaderReloaded(name, shader);
+	});
 
   // Load shader into shader manager and retrieve it
   shapeShader = this->shaderManager->loadShader("../res/shaders/shape.vert",
@@ -81,122 +195,301 @@ void Engine::initShaders()
   shapeShader.use();
   shapeShader.setMatrix4("projection", this->PROJECTION);
 
-  // Configure text shader and renderer
-  textShader = shaderManager->loadShader(
-      "../res/shaders/text.vert", "../res/shaders/text.frag", nullptr, "text");
-  fontRenderer = make_unique<FontRenderer>(
-      shaderManager->getShader("text"), "../res/fonts/MxPlus_IBM_BIOS.ttf", 24);
-
+  circleShader = shaderManager->loadShader("../res/shaders/circle.vert",
+					   "../res/shaders/circle.frag",
+					   nullptr, "circle");
+  circleShader.use();
+  circleShader.setMatrix4("projection", this->PROJECTION);
+
+  cloudShader = shaderManager->loadShader("../res/shaders/cloud.vert",
+					  "../res/shaders/cloud.frag", nullptr,
+					  "cloud");
+  cloudShader.use();
+  cloudShader.setMatrix4("projection", this->PROJECTION);
+  // Three layers of clouds in the upper part of the sky, far to near. Fixed
+  // seeds so offscreen runs render the same frames.
+  background = make_unique<ParallaxBackground>(cloudShader, width);
+  background->addLayer({8.0f, 0.6f, color(1, 1, 1, 0.35f)}, 24, height * 0.45f,
+		       height - 20.0f, 1);
+  background->addLayer({20.0f, 0.9f, color(1, 1, 1, 0.55f)}, 14,
+		       height * 0.4f, height - 40.0f, 2);
+  background->addLayer({40.0f, 1.3f, color(1, 1, 1, 0.8f)}, 8, height * 0.35f,
+		       height - 60.0f, 3);
+
+  // Text renderers start without a font; the text shader and fonts are read
+  // on workers and uploaded by render() a slice at a time. Uploads run in
+  // request order, so the shader is compiled before either font is set.
+  fontRenderer = make_unique<FontRenderer>(textShader);
   // Create a textbox for displaying a message
-  messageTextbox = make_unique<Textbox>(
-      shapeShader, textShader, vec2(width / 2, height / 5), vec2(400, 100),
-      black, "../res/fonts/MxPlus_IBM_BIOS.ttf");
+  messageTextbox = make_unique<Textbox>(shapeShader, textShader,
+					vec2(width / 2, height / 5),
+					vec2(400, 100), black, "");
+
+  assets.load([this] {
+    auto source = make_shared<ShaderSource>(ShaderManager::readShaderSource(
+	"../res/shaders/text.vert", "../res/shaders/text.frag"));
+    return AssetLoader::Upload([this, source] {
+      textShader = shaderManager->loadShaderFromSource(*source, "text");
+      return true;
+    });
+  });
+  loadFontAsync(24, [this](map<char, Character> glyphs) {
+    fontRenderer->setFont(textShader, std::move(glyphs));
+  });
+  loadFontAsync(static_cast<unsigned int>(messageTextbox->getFontSize()),
+		[this](map<char, Character> glyphs) {
+		  messageTextbox->setFont(std::move(glyphs));
+		});
+  // Creature table for encounters
+  assets.load([this] {
+    PROFILE_ZONE("load creatures");
+    auto loaded = make_shared<vector<entityInfo>>(
+	loadEntityInfo("entity-data/enemy_creatureinfo.csv"));
+    return AssetLoader::Upload([this, loaded] {
+      creatures = std::move(*loaded);
+      // Every name an encounter can need is stored now rather than on the
+      // first meeting
+      for (const entityInfo &creature : creatures)
+	combatants.internName(creature.name, creature.description);
+      // initShapes() had nothing to pick the first enemy from
+      prefetchEnemy();
+      return true;
+    });
+  });
+
   // Set projection for textbox
   messageTextbox->setProjection(PROJECTION);
   messageTextbox->enableScrolling(15.0f);
 
+  // Performance overlay panel in the top left corner
+  perfHudBackground = make_unique<Rect>(shapeShader, vec2(115, height - 89),
+					vec2(220, 168), color(0, 0, 0, 0.6f));
+
   // If none of the above is intuitive feel free to check Textbox.cpp, all of
   // these methods are explained there.
 }
 
-void Engine::initShapes()
+void Engine::reloadChangedShaders()
 {
-  // Initializing user (member of engine) as a white rectangle
-  user =
-      make_unique<Rect>(shapeShader, vec2(width / 2, 100), vec2(20, 20), white);
-  // Clearing platforms for any sort of problems
-  platforms.clear();
-  // First index of platforms is always the 'ground'.
-  platforms.push_back(make_unique<Rect>(shapeShader, vec2(width / 2, 50),
-					vec2(width, platformHeight * 10),
-					green));
-  /*
-   * This loop generate the main platform each time initShapes is called.
-   * Initial height for platforms is 200, and iterates up until window height -
-   * 100 pixels. Then, height has a random y value to add to it
-   */
-  for (float y = 200; y < height - 100; y += rand() % 50 + 30)
+  // Files are reread on a worker; the compile and swap run as an upload so
+  // they share the frame's asset budget
+  for (const string &name : shaderManager->changedShaders())
+    assets.load([this, name] {
+      auto source =
+	  make_shared<ShaderSource>(shaderManager->sourceFor(name));
+      return AssetLoader::Upload([this, name, source] {
+	shaderManager->reload(name, *source);
+	return true;
+      });
+    });
+}
+
+void Engine::shaderReloaded(const string &name, Shader &shader)
+{
+  if (name == "shape")
+  {
+    shapeShader = shader;
+    // Only set once in initShaders()
+    shapeShader.use();
+    shapeShader.setMatrix4("projection", this->PROJECTION);
+  }
+  else if (name == "circle")
+  {
+    circleShader = shader;
+    circleShader.use();
+    circleShader.setMatrix4("projection", this->PROJECTION);
+  }
+  else if (name == "cloud")
   {
-    // X value for platforms varies anywhere on the x axis within 100 pixels of
-    // window width (50px on each side)
-    float x = rand() % (width - 100) + 50;
-    // Width of platforms is also random
-    float platformWidth = rand() % 100 + 80;
-
-    platforms.push_back(make_unique<Rect>(
-	shapeShader, vec2(x, y), vec2(platformWidth, platformHeight), green));
+    cloudShader = shader;
+    cloudShader.use();
+    cloudShader.setMatrix4("projection", this->PROJECTION);
   }
-  // After platforms vector is populated, add a 'goal' square to the highest
-  // identifiable
-  if (!platforms.empty())
+  else if (name == "text")
   {
-    float yValue = 0;
-    float xValue = 0;
-    // Reference variable for each unique platform. For each loop to simplify
-    // and have easier access.
-    for (const unique_ptr<Rect> &platform : platforms)
+    textShader = shader;
+    fontRenderer->setShader(textShader);
+    messageTextbox->textShaderChanged();
+  }
+}
+
+void Engine::loadFontAsync(
+    unsigned int fontSize, function<void(map<char, Character>)> onLoaded)
+{
+  assets.load([fontSize, onLoaded = std::move(onLoaded)] {
+    PROFILE_ZONE("decode font");
+    auto bitmaps = make_shared<vector<GlyphBitmap>>(
+	Font::decode("../res/fonts/MxPlus_IBM_BIOS.ttf", fontSize));
+    auto glyphs = make_shared<map<char, Character>>();
+    auto next = make_shared<size_t>(0);
+    // A few glyph textures per step, handing the font over after the last
+    return AssetLoader::Upload([bitmaps, glyphs, next, onLoaded] {
+      const size_t end = min(*next + glyphsPerUploadStep, bitmaps->size());
+      for (; *next < end; ++*next)
+	glyphs->emplace((*bitmaps)[*next].c,
+			Font::upload((*bitmaps)[*next]));
+      if (*next < bitmaps->size())
+	return false;
+      onLoaded(std::move(*glyphs));
+      return true;
+    });
+  });
+}
+
+void Engine::initShapes()
+{
+  PROFILE_ZONE("init shapes");
+  // The level is one screen per chunk, laid out on worker threads. Only
+  // creating the player overlaps the first layouts here; the real gain is
+  // update() in play, which lays out chunks ahead without stalling a frame
+  if (!levels)
+    levels = make_unique<LevelStream>(jobs, shapeShader, green, width,
+				      static_cast<float>(height),
+				      platformHeight);
+  levels->reset(rand());
+  levels->update(0.0f, static_cast<float>(height));
+
+  // Initializing user (member of engine) as a white rectangle, once; a new
+  // game only moves it back
+  if (!user)
     {
-      if (platform->getPos().y > yValue)
-      {
-	// Setting goal's position to the last platform in the vector.
-	yValue = platform->getPos().y;
-	xValue = platform->getPos().x;
-      }
+      user = make_unique<Rect>(shapeShader, vec2(width / 2, 100),
+			       vec2(20, 20), white);
+      nextPosRect = make_unique<Rect>(shapeShader, user->getPos(),
+				      user->getSize(), white);
     }
-    goal = make_unique<Rect>(shapeShader, vec2(xValue, yValue + 20),
-			     vec2(20, 20), red);
+  user->setPos(vec2(width / 2, 100));
+
+  // The first chunks (the ground and a screen of platforms in chunk 0) have
+  // to be there for the first frame
+  levels->finish();
+  // The first goal is above the highest platform of the first screen
+  goals.release(goal);
+  goals.release(nextGoal);
+  goal = nextGoal = {};
+  goalChunk = 0;
+  placeGoal();
+  prefetchEnemy();
+  if (climber)
+    climber->reset();
+  frameLevel();
+  camera.setPosition(vec2(width / 2.0f, user->getPosY()));
+}
+
+void Engine::frameLevel()
+{
+  // Chunks that aren't built yet (or were dropped) have nothing to show
+  camera.setVerticalLimits(levels->getBottom(), levels->getTop());
+}
+
+void Engine::placeGoal()
+{
+  // A goal the player climbed past without touching moves to the chunk above
+  const Rect *current = goals.get(goal);
+  if (current && current->getTop() < camera.getView().min.y)
+  {
+    goals.release(goal);
+    goals.release(nextGoal);
+    goal = nextGoal = {};
+    goalChunk = levels->chunkAt(user->getPosY()) + 1;
   }
+  vec2 position;
+  if (!goals.valid(goal) && levels->findGoal(goalChunk, position))
+    goal = makeGoal(position);
+  // The one after is ready before this one is reached, so reaching it
+  // doesn't create any GL objects
+  if (goals.valid(goal) && !goals.valid(nextGoal)
+      && levels->findGoal(goalChunk + 1, position))
+    nextGoal = makeGoal(position);
+}
+
+ObjectPool<Rect>::Handle Engine::makeGoal(vec2 position)
+{
+  // Only the first two goals are ever constructed; after that they are the
+  // squares the player already reached (or climbed past)
+  return goals.acquire([position](Rect &square) { square.setPos(position); },
+		       shapeShader, position, vec2(20, 20), red);
+}
+
+void Engine::prefetchEnemy()
+{
+  // A new game keeps an enemy that's already waiting
+  if (nextEnemy != noCombatant)
+    return;
+  // Until the creature table is uploaded there is nothing to pick from; its
+  // upload callback starts the first prefetch
+  if (creatures.empty())
+    return;
+  // Spawning fills in a few component slots (the name is already interned),
+  // so it's done right here on the main thread, which owns rand()
+  nextEnemy = combatants.spawn(creatures[rand() % creatures.size()],
+			       CombatSide::Enemy);
 }
 
+/// @brief Keys that feed events to the game state machine. Events that the
+/// current state has no transition for are ignored, so R can mean both Run (in
+/// battle) and Restart (on the game over screen).
+struct KeyBinding
+{
+  int key;
+  GameEvent event;
+};
+const KeyBinding keyBindings[] = {
+    {GLFW_KEY_ENTER, GameEvent::Confirm}, {GLFW_KEY_I, GameEvent::ShowInfo},
+    {GLFW_KEY_M, GameEvent::SecretMenu},  {GLFW_KEY_A, GameEvent::Attack},
+    {GLFW_KEY_D, GameEvent::Defend},      {GLFW_KEY_V, GameEvent::View},
+    {GLFW_KEY_R, GameEvent::Run},         {GLFW_KEY_R, GameEvent::Restart},
+    {GLFW_KEY_B, GameEvent::Die},
+};
+
 void Engine::processInput()
 {
-  glfwPollEvents();
-  // Set keys to true if pressed, false if released
-  for (int key = 0; key < 1024; ++key)
+  PROFILE_ZONE("input");
+  // Offscreen runs have no window to poll, keys come from setKey()
+  if (!config.offscreen)
   {
-    if (glfwGetKey(window, key) == GLFW_PRESS)
-      keys[key] = true;
-    else if (glfwGetKey(window, key) == GLFW_RELEASE)
-      keys[key] = false;
+    glfwPollEvents();
+    // Set keys to true if pressed, false if released
+    for (int key = 0; key < 1024; ++key)
+    {
+      if (glfwGetKey(window, key) == GLFW_PRESS)
+	keys[key] = true;
+      else if (glfwGetKey(window, key) == GLFW_RELEASE)
+	keys[key] = false;
+    }
   }
+  if (climber)
+    pressAutoplayKeys();
   // Close window if escape key is pressed
-  if (keys[GLFW_KEY_ESCAPE])
+  if (keys[GLFW_KEY_ESCAPE] && window)
     glfwSetWindowShouldClose(window, true);
 
+  // Toggle the performance overlay once per F3 press (on any screen)
+  if (keys[GLFW_KEY_F3] && !perfHudKeyHeld)
+    showPerfHud = !showPerfHud;
+  perfHudKeyHeld = keys[GLFW_KEY_F3];
+
   /*
-   * screen state logic
+   * Menu and battle input: each new key press becomes one event for the state
+   * machine (see game/gameStateMachine.cpp for what every state does with it).
+   * Only the first binding of a key that the state accepts is used, so one
+   * press can't trigger two transitions.
    */
-  switch (screen)
+  for (const KeyBinding &binding : keyBindings)
   {
-  case start:
-    infoTextDisplayed = false;
-    // progress past intro screen dialogue
-    if (keys[GLFW_KEY_ENTER])
-    {
-      screen = play;
-      messageTextbox->close();
-    }
-    // display information text to user
-    if (keys[GLFW_KEY_I])
-    {
-      messageTextbox->open();
-      messageTextbox->setText(
-	  "Here's the deal. You're a knight wandering the dark plain. You're "
-	  "going to encounter various *enemies* and they will try to attack "
-	  "you. Beware, you can Attack, Defend, View and Run. If you are to "
-	  "perish, you shall be reborn anew. So don't fret! Urist be with "
-	  "you.");
-      infoTextDisplayed = true;
-    }
-    break;
-  case play:
-    // Secret menu functionality. This was moreso for testing but I kept it in
-    // the game for demoing purposes.
-    if (keys[GLFW_KEY_M])
+    if (keys[binding.key] && !keysHandled[binding.key])
     {
-      messageTextbox->open();
-      messageTextbox->setText("You just opened a secret menu!");
+      ALLOCATION_SCOPE(Battle);
+      if (game.dispatch(binding.event, session))
+	keysHandled[binding.key] = true;
     }
+  }
+  // A held key that no state wanted this frame shouldn't fire later either
+  for (const KeyBinding &binding : keyBindings)
+    keysHandled[binding.key] = keys[binding.key];
+
+  if (game.getState() == GameState::Play)
+  {
     // Setting player's horizontal velocity to zero everytime an input is read
     playerVelocity.x = 0;
 
@@ -220,95 +513,6 @@ void Engine::processInput()
       playerVelocity.y = jumpForce;
       onGround = false;
     }
-    break;
-  case battle:
-    // Deathfunctionality. This was also for testing but I kept it in the game
-    // for demoing purposes. Player can perish by gameplay, but this expedites
-    // it so all screens can be rendered properly.
-    if (keys[GLFW_KEY_B])
-    {
-      // Transition to game over screen
-      screen = over;
-      messageTextbox->setText("You have died...");
-      // Slow scrolling for dramatic effect
-      messageTextbox->enableScrolling(5.0f);
-    }
-    if (keys[GLFW_KEY_ENTER])
-    {
-      /*
-       * ALRIGHT.. This might look messy. It is, I'm using a few different flags
-       * to display varying text that can be displayed by an enemy in the battle
-       * screen. If there is no battle (yet) display the text and start the
-       * battle (enable players turn)
-       */
-      if (!isBattling)
-      {
-	isBattling = true;
-	isPlayerTurn = true;
-      }
-      // If the enemy has attacked (flags changed in update logic) then another
-      // enter should progress past their displayed text for the next phase in
-      // the battle.
-      if (enemyTextDisplayed)
-      {
-	enemyTextDisplayed = false;
-	waitingForEnter = true;
-	playerInAction = false;
-	isPlayerTurn = true;
-	battleTextDisplayed = false;
-      }
-      // Similar logic to above
-      else if (!isPlayerTurn && playerInAction)
-      {
-	isEnemyTurn = true;
-      }
-    }
-    // I'm not sure this is working but I'm too afraid to remove it so it doesnt
-    // break
-    if (waitingForEnter)
-    {
-      if (keys[GLFW_KEY_ENTER])
-      {
-	waitingForEnter = false;
-      }
-    }
-    // Listed attack options in battle mode, flagging each one individually
-    if (isPlayerTurn && !playerInAction)
-    {
-      if (keys[GLFW_KEY_A])
-      {
-	// Attack
-	playerInAction = true;
-	playerAttacking = true;
-      }
-      if (keys[GLFW_KEY_D])
-      {
-	// Defend
-	playerInAction = true;
-	playerDefending = true;
-      }
-      if (keys[GLFW_KEY_V])
-      {
-	// View
-	playerInAction = true;
-	playerViewing = true;
-      }
-      if (keys[GLFW_KEY_R])
-      {
-	// Run
-	playerInAction = true;
-	playerRunning = true;
-      }
-    }
-    break;
-  case over:
-    // Restart game if you died.
-    if (keys[GLFW_KEY_R])
-    {
-      screen = start; // Restart the game
-      this->initShapes();
-    }
-    break;
   }
   // Close textboxes with Q at *any* time (persistent among screens)
   if ((keys[GLFW_KEY_Q]) && messageTextbox->shouldClose)
@@ -320,324 +524,363 @@ void Engine::processInput()
 
 void Engine::update()
 {
-  // deltaTime calculations referenced from previous M4GPs
-  float currentFrame = glfwGetTime();
+  PROFILE_ZONE("update");
+  // deltaTime calculations referenced from previous M4GPs. Offscreen runs step
+  // a fixed 60th of a second per frame so every run renders the same frames.
+  float currentFrame =
+      config.offscreen ? frameIndex / 60.0f : static_cast<float>(glfwGetTime());
   deltaTime = currentFrame - lastFrame;
   lastFrame = currentFrame;
 
-  /*
-   *Update screen state logic
-   */
-  switch (screen)
+  // Menus and battles only change on input (processInput), platforming (and
+  // the clouds drifting behind it) is the only state with per-frame work
+  if (game.getState() == GameState::Play)
   {
-  case start:
-    // Initialize textbox to welcome text. Pretty straightforward.
-    if (messageTextbox->getText() == "" && !infoTextDisplayed)
+    background->update(deltaTime);
     {
-      messageTextbox->setText("Welcome to the game! Press enter to continue, "
-			      "or press (i) for game info");
+      ALLOCATION_SCOPE(Level);
+      const CollisionAabb view = camera.getView();
+      levels->update(view.min.y, view.max.y);
+      // Offscreen runs must get the same level every run, whatever the
+      // workers' timing
+      if (config.offscreen)
+	levels->finish();
+      frameLevel();
+      placeGoal();
     }
-    break;
+    updatePlatforming();
+  }
+}
 
-  /*
-   * PHYSICS CALCULATIONS FOR PLAYER MOVEMENT
-   *
-   * this is in update
-   */
-  case play: {
+/*
+ * PHYSICS CALCULATIONS FOR PLAYER MOVEMENT
+ */
+void Engine::updatePlatforming()
+{
+  ALLOCATION_SCOPE(Physics);
+  vec2 nextPos;
+  {
+    PROFILE_ZONE("physics");
     // Player's horizontal velocity is always being weighed down by gravity
     playerVelocity.y -= gravity * deltaTime;
-    // Creating a new vector that copy's player's current position, adding both
-    // vertical and horizontal velocity each frame
-    vec2 nextPos = user->getPos();
+    // Creating a new vector that copy's player's current position, adding
+    // both vertical and horizontal velocity each frame
+    nextPos = user->getPos();
     nextPos.x += playerVelocity.x * deltaTime;
     nextPos.y += playerVelocity.y * deltaTime;
 
     // Resetting this each frame
     onGround = false;
+  }
 
-    // Next frame collisions
-    Rect nextPosRect(shapeShader, nextPos, user->getSize(), white);
-
-    // Check collisions with all platforms
-    for (const unique_ptr<Rect> &platform : platforms)
-    {
-      if (Rect::isOverlapping(nextPosRect, *platform))
-      {
-	vec2 currentPos = user->getPos();
-
-	// Landing on top of a platform
-	if (currentPos.y > platform->getPos().y && playerVelocity.y < 0)
-	{
-	  nextPos.y = platform->getTop() + user->getSize().y / 2;
-	  playerVelocity.y = 0;
-	  onGround = true;
-	}
-	// If player is below a platform when jumping
-	else if (currentPos.y < platform->getPos().y && playerVelocity.y > 0)
-	{
-	  nextPos.y = platform->getBottom() - user->getSize().y / 2;
-	  playerVelocity.y = 0;
-	}
-	// If player is to the left of a platform when moving horizontally
-	else if (currentPos.x < platform->getPos().x)
-	{
-	  nextPos.x = platform->getLeft() - user->getSize().x / 2;
-	  playerVelocity.x = 0;
-	}
-	// If player is to the right of a platform when moving horizontally
-	else if (currentPos.x > platform->getPos().x)
-	{
-	  nextPos.x = platform->getRight() + user->getSize().x / 2;
-	  playerVelocity.x = 0;
-	}
-      }
-    }
-
-    // Check collision with goal
-    if (Rect::isOverlapping(nextPosRect, *goal))
-    {
-      score++;
-      platforms.clear();
-
-      // Create a small platform below the player
-      platforms.push_back(
-	  make_unique<Rect>(shapeShader, vec2(user->getPosX(), user->getPosY()),
-			    vec2(width / 5, platformHeight), green));
-
-      // Generate new platforms
-      for (float y = 200; y < height - 100; y += rand() % 50 + 30)
-      {
-	float x = rand() % (width - 100) + 50;
-	float platformWidth = rand() % 100 + 80;
-	platforms.push_back(
-	    make_unique<Rect>(shapeShader, vec2(x, y),
-			      vec2(platformWidth, platformHeight), green));
-      }
+  // Next frame collisions
+  nextPosRect->setPos(nextPos);
+  nextPosRect->setSize(user->getSize());
 
-      // Update goal position
-      if (!platforms.empty())
-      {
-	float yValue = 0;
-	float xValue = 0;
-	for (const unique_ptr<Rect> &platform : platforms)
-	{
-	  if (platform->getPos().y > yValue)
-	  {
-	    yValue = platform->getPos().y;
-	    xValue = platform->getPos().x;
-	  }
-	}
-	goal = make_unique<Rect>(shapeShader, vec2(xValue, yValue + 20),
-				 vec2(20, 20), red);
-      }
-      // A "goal" in this case is an enemy, and we want to attack it!
-      // Progress to battle screen
-      screen = battle;
-      // Setting battle flags
-      isBattling = false;
-      playerInAction = false;
-      battleTextDisplayed = false;
-
-      // generate battle with enemy:
-      currentEnemy = make_unique<enemy>();
-
-      cout << "[DEBUG] Entering battle. Flags: isBattling=" << isBattling
-	   << " isPlayerTurn=" << isPlayerTurn
-	   << " playerRunning=" << playerRunning << "\n";
-      messageTextbox->setText(
-	  "You have encountered a " + currentEnemy->getName() + "\n" +
-	  currentEnemy->getDescription() + "\nWhat do you do?");
-      messageTextbox->open();
-    }
+  // Check collisions with all platforms
+  {
+    PROFILE_ZONE("collision");
+    if (resolvePlatformCollisions(levels->getPlatforms(), user->getPos(),
+				  *nextPosRect, nextPos, playerVelocity))
+      onGround = true;
+  }
 
-    // Update player position
-    user->setPos(nextPos);
+  // Check collision with goal
+  const Rect *reached = goals.get(goal);
+  if (reached && Rect::isOverlapping(*nextPosRect, *reached))
+  {
+    PROFILE_ZONE("level transition");
+    ALLOCATION_SCOPE(Battle);
+    score++;
+    // The level carries on; the goal in the chunk above (made by placeGoal()
+    // while this one was played) takes over
+    goals.release(goal);
+    goal = nextGoal;
+    nextGoal = {};
+    goalChunk++;
+
+    // A "goal" in this case is an enemy, and we want to attack it!
+    // The enemy was spawned while the level was played, so progressing to the
+    // battle screen is an id swap. The last enemy leaves the registry and its
+    // slots go to the next one. A goal reached before the creature table is
+    // in waits for it (the upload spawns the enemy); without a table there is
+    // nobody to fight
+    if (nextEnemy == noCombatant)
+      assets.finish();
+    if (session.opponent != noCombatant)
+      combatants.destroy(session.opponent);
+    session.opponent = nextEnemy;
+    nextEnemy = noCombatant;
+    prefetchEnemy();
+    if (session.opponent != noCombatant)
+      game.dispatch(GameEvent::GoalReached, session);
+  }
 
-    // Check if player has fallen too far
-    if (user->getPos().y < 0)
-    {
-      resetGame = true;
-    }
+  // Update player position
+  user->setPos(nextPos);
+  // Levels are a screen wide, so the camera only follows the player
+  // vertically
+  camera.follow(vec2(width / 2.0f, user->getPosY()), deltaTime);
 
-    // Reset if needed
-    if (resetGame)
-    {
-      playerVelocity = vec2(0, 0);
-      onGround = false;
-      this->initShapes();
-      resetGame = false;
-    }
-    break;
+  // Check if player has fallen below the part of the level that's still there
+  if (user->getPos().y < levels->getBottom())
+  {
+    resetGame = true;
   }
 
-  case battle:
-    /*
-     * Player turn for battle. Firstly, display to the user their options, then
-     * make sure the player and current enemy are alive, otherwise change
-     * screens.
-     *
-     * playerAttacking/Defending etc conditionals are modified in processInput()
-     * for A,D,V,R
-     */
-    if (isPlayerTurn)
-    {
-      if (!battleTextDisplayed && !waitingForEnter)
-      {
-	messageTextbox->setText("(A)ttack.\n(D)efend.\n(V)iew.\n(R)un.");
-	battleTextDisplayed = true;
-	playerInAction = false;
-	playerRunning = false;
-	playerDefending = false;
-	playerViewing = false;
-	infoTextDisplayed = false;
-      }
-      if (currentEnemy->getHealth() <= 0)
-      {
-	screen = play;
-	messageTextbox->setText("You defeated " + currentEnemy->getName());
-      }
-      if (playerCharacter->getHealth() <= 0)
-      {
-	screen = over;
-      }
-
-      /*
-       * Calls game logic and sets the string returned to the textbox message
-       */
-      if (playerAttacking)
-      {
-	srand(time(0));
-	string digest =
-	    playerCharacter->attackAgainst(*currentEnemy, rand() % 50);
-	digest += "\n" + currentEnemy->move_against(*playerCharacter);
-	messageTextbox->setText(digest);
-
-	// Game flags for proper input processing
-	playerAttacking = false;
-	isPlayerTurn = false;
-	playerInAction = true;
-	// Reset battleTextDisplayed to allow displaying options again
-	battleTextDisplayed = false;
-	// Reset enemyTextDisplayed to allow new text
-	enemyTextDisplayed = false;
-      }
-      // Very similiar to playerAttacking structure
-      if (playerDefending)
-      {
-	// Similar logic to attacking
-	playerDefending = false;
-	isPlayerTurn = false;
-	playerInAction = true;
-	string digest = playerCharacter->defendAgainst(*currentEnemy);
-	digest += "\n" + currentEnemy->move_against(*playerCharacter);
-	messageTextbox->setText(digest);
-
-	battleTextDisplayed = false;
-	enemyTextDisplayed = false;
-      }
-      if (playerViewing)
-      {
-	// View stats for the enemy and player
-	messageTextbox->setText(
-	    "Your Health: " + to_string(playerCharacter->getHealth()) + "\n" +
-	    "Enemy Health: " + to_string(currentEnemy->getHealth()));
-	playerViewing = false;
-	isPlayerTurn = false;
-	playerInAction = true;
-
-	battleTextDisplayed = false;
-	enemyTextDisplayed = false;
-      }
-      if (playerRunning)
-      {
-	// Run away. Pretty straightforward.
-	screen = play;
-	playerRunning = false;
-	isPlayerTurn = false;
-	playerInAction = true;
-
-	battleTextDisplayed = false;
-	enemyTextDisplayed = false;
-	messageTextbox->setText("You ran away!");
-      }
-    }
-    else if (!isPlayerTurn)
-    {
-      if (isEnemyTurn && !enemyTextDisplayed)
-      {
+  // Reset if needed
+  if (resetGame)
+  {
+    playerVelocity = vec2(0, 0);
+    onGround = false;
+    this->initShapes();
+    resetGame = false;
+  }
+}
 
-	/*
-	 * Pretty much serves as a switch that activates/deactivates certain
-	 * text progression in battle screen, if the player has already attacked
-	 * and battleText is still displaying, cant automatically jump to next
-	 * player attack.
-	 */
-	enemyTextDisplayed = true;
-	isEnemyTurn = false;
-	waitingForEnter = true;
-	battleTextDisplayed = false;
-	isPlayerTurn = true;
-      }
-    }
-    break;
+void Engine::showMessage(const string &text, float scrollSpeed)
+{
+  messageTextbox->enableScrolling(scrollSpeed);
+  messageTextbox->setText(text);
+  messageTextbox->open();
+}
 
-    break;
+void Engine::hideMessage() { messageTextbox->close(); }
 
-  case over:
-    // Logic for over screen (e.g., restart checks)
-    break;
-  }
+void Engine::resetLevel()
+{
+  playerVelocity = vec2(0, 0);
+  onGround = false;
+  this->initShapes();
 }
 
 void Engine::render()
 {
+  PROFILE_ZONE("render");
+  ALLOCATION_SCOPE(Render);
+  // Read back GPU timings from previous frames
+  Profiler::collectGpuTimers();
+  // Finish a slice of any assets still loading (or shaders being reloaded)
+  reloadChangedShaders();
+  if (assets.pending())
+    assets.pumpUploads(assetUploadBudget);
+
   glClearColor(blue.red, blue.green, blue.blue, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT);
   shapeShader.use();
 
-  switch (screen)
+  switch (game.getState())
   {
-  case start: {
-    glClearColor(0.5f, 0.5f, 0.5f, 0.5f);
-    glClear(GL_COLOR_BUFFER_BIT);
-    break;
-  }
-  case play: {
-    // Iterating through platforms, for each platform setunfirm and draw.
-    for (const unique_ptr<Rect> &platform : platforms)
+  case GameState::Play: {
+    PROFILE_ZONE("shapes");
+    PROFILE_GPU_ZONE("shapes");
+    // The sky stays put; everything else is drawn through the camera
+    background->draw();
+    const mat4 viewProjection = camera.getViewProjection();
+    shapeShader.use();
+    shapeShader.setMatrix4("projection", viewProjection);
+    // Only platforms inside the view are drawn
+    Metrics::add(Metric::Culled,
+		 camera.cull(levels->getPlatforms(), visiblePlatforms));
+    for (const Rect *platform : visiblePlatforms)
     {
-      if (platform)
-      {
-	platform->setUniforms();
-	platform->draw();
-      }
+      platform->setUniforms();
+      platform->draw();
     }
     shapeShader.use();
 
     // Draw goal
-    goal->setUniforms();
-    goal->draw();
+    const Rect *shownGoal = goals.get(goal);
+    if (shownGoal && camera.isVisible(aabbOf(*shownGoal)))
+    {
+      shownGoal->setUniforms();
+      shownGoal->draw();
+    }
 
     // Draw player
     user->setUniforms();
     user->draw();
+
+    // Back to screen coordinates for the textbox and overlay
+    shapeShader.use();
+    shapeShader.setMatrix4("projection", this->PROJECTION);
     break;
   }
-  case battle: {
-    glClearColor(0.5f, 0.5f, 0.5f, 0.5f);
+  case GameState::Over: {
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_COLOR_BUFFER_BIT);
     break;
   }
-  case over: {
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+  // Start screen and battle screens
+  default: {
+    glClearColor(0.5f, 0.5f, 0.5f, 0.5f);
     glClear(GL_COLOR_BUFFER_BIT);
     break;
   }
   }
-  messageTextbox->setUniforms();
-  messageTextbox->draw(deltaTime);
-  glfwSwapBuffers(window);
+  {
+    PROFILE_ZONE("text");
+    ALLOCATION_SCOPE(Text);
+    PROFILE_GPU_ZONE("text");
+    messageTextbox->setUniforms();
+    messageTextbox->draw(deltaTime);
+  }
+  if (showPerfHud)
+    renderPerfHud();
+  present();
+  // Nothing allocated from the frame arena outlives the frame
+  Metrics::add(Metric::ArenaBytes, FrameArena::frame().used());
+  FrameArena::frame().reset();
+  Metrics::endFrame(deltaTime);
+  if (config.allocationCheckAfter && frameIndex > config.allocationCheckAfter)
+    checkFrameAllocations();
+}
+
+void Engine::checkFrameAllocations()
+{
+  const uint64_t count = Metrics::lastFrame(Metric::HeapAllocations);
+  if (count == 0)
+    return;
+  allocatingFrames++;
+  // Counters of the frame that just ended. std::cerr is unbuffered, so the
+  // report doesn't show up as an allocation of the next frame
+  std::cerr << "Frame " << frameIndex - 1 << " made " << count
+	    << " heap allocations ("
+	    << Metrics::lastFrame(Metric::HeapBytes) << " bytes):";
+  for (int i = 0; i < static_cast<int>(AllocationScope::Count); ++i)
+  {
+    const AllocationScope scope = static_cast<AllocationScope>(i);
+    const AllocationStats stats = Metrics::lastFrame(scope);
+    if (stats.count)
+      std::cerr << ' ' << Metrics::name(scope) << ' ' << stats.count << " ("
+		<< stats.bytes << " bytes)";
+  }
+  std::cerr << std::endl;
 }
 
-bool Engine::shouldClose() { return glfwWindowShouldClose(window); }
+void Engine::present()
+{
+  PROFILE_ZONE("swap");
+  // Streamed vertices written this frame can be reused once the GPU passes
+  // this point
+  StreamBuffer::shared().fenceFrame();
+  if (config.offscreen)
+  {
+    if (!config.frameDumpDir.empty())
+    {
+      char fileName[32];
+      snprintf(fileName, sizeof(fileName), "/frame_%05lu.png", frameIndex);
+      saveFrame(config.frameDumpDir + fileName);
+    }
+  }
+  else
+  {
+    glfwSwapBuffers(window);
+  }
+  frameIndex++;
+
+  if (frameLimiter)
+  {
+    PROFILE_ZONE("frame limiter");
+    frameLimiter->wait();
+  }
+}
+
+void Engine::setKey(int key, bool pressed)
+{
+  if (key >= 0 && key < 1024)
+    keys[key] = pressed;
+}
+
+void Engine::pressAutoplayKeys()
+{
+  const int scripted[] = {GLFW_KEY_ENTER, GLFW_KEY_A,     GLFW_KEY_R,
+			  GLFW_KEY_LEFT,  GLFW_KEY_RIGHT, GLFW_KEY_UP};
+  for (int key : scripted)
+    setKey(key, false);
+
+  // Released in between, so every press is a new one (see keysHandled)
+  const bool press = frameIndex % 2 == 0;
+  switch (game.getState())
+  {
+  case GameState::Start:
+  case GameState::Encounter:
+  case GameState::TurnResult:
+    setKey(GLFW_KEY_ENTER, press);
+    break;
+  case GameState::PlayerTurn:
+    setKey(GLFW_KEY_A, press);
+    break;
+  case GameState::Over:
+    setKey(GLFW_KEY_R, press);
+    break;
+  case GameState::Play: {
+    const ClimbKeys held = climber->update(*user, onGround,
+					   levels->getPlatforms(), goals.get(goal));
+    setKey(GLFW_KEY_LEFT, held.left);
+    setKey(GLFW_KEY_RIGHT, held.right);
+    setKey(GLFW_KEY_UP, held.jump);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+bool Engine::saveFrame(const string &path) const
+{
+  if (!offscreenTarget)
+    return false;
+  bool saved = offscreenTarget->savePng(path);
+  // Reading back binds the framebuffer for reading only, keep drawing into it
+  offscreenTarget->bind();
+  return saved;
+}
+
+void Engine::renderPerfHud()
+{
+  PROFILE_ZONE("perf hud");
+  ALLOCATION_SCOPE(Text);
+  shapeShader.use();
+  perfHudBackground->setUniforms();
+  perfHudBackground->draw();
+
+  // Counters are from the last completed frame, so the overlay doesn't measure
+  // itself
+  char line[64];
+  float y = height - 20.0f;
+  const float lineHeight = 16.0f;
+  const vec3 textColor(1.0f, 1.0f, 1.0f);
+
+  FrameTimeSummary frameTimes = Metrics::summarizeFrameTimes();
+  snprintf(line, sizeof(line), "p50 %.2f ms  p95 %.2f", frameTimes.p50,
+	   frameTimes.p95);
+  fontRenderer->renderText(line, 12.0f, y, PROJECTION, 0.5f, textColor);
+  y -= lineHeight;
+  snprintf(line, sizeof(line), "p99 %.2f ms  max %.2f", frameTimes.p99,
+	   frameTimes.worst);
+  fontRenderer->renderText(line, 12.0f, y, PROJECTION, 0.5f, textColor);
+
+  for (int i = 0; i < static_cast<int>(Metric::Count); ++i)
+  {
+    Metric metric = static_cast<Metric>(i);
+#ifndef RUNNER_COUNT_ALLOCATIONS
+    // Nothing counts heap allocations in this build
+    if (metric == Metric::HeapAllocations || metric == Metric::HeapBytes)
+      continue;
+#endif
+    y -= lineHeight;
+    snprintf(line, sizeof(line), "%-14s %llu", Metrics::name(metric),
+	     static_cast<unsigned long long>(Metrics::lastFrame(metric)));
+    fontRenderer->renderText(line, 12.0f, y, PROJECTION, 0.5f, textColor);
+  }
+}
+
+bool Engine::shouldClose()
+{
+  if (config.frameLimit && frameIndex >= config.frameLimit)
+    return true;
+  if (config.offscreen)
+    return keys[GLFW_KEY_ESCAPE];
+  return glfwWindowShouldClose(window);
+}
@@ -8,28 +8,133 @@
 #include <glad/glad.h>
 
 #include "font/fontRenderer.h"
-#include "game/enemy.h"
+#include "game/autoplay.h"
+#include "game/combatRegistry.h"
+#include "game/gameStateMachine.h"
+#include "game/levelStream.h"
+#include "render/camera.h"
+#include "render/framebuffer.h"
+#include "render/offscreenContext.h"
 #include "shader/shaderManager.h"
 #include "shapes/Cloud.h"
+#include "shapes/parallaxBackground.h"
 #include "shapes/rect.h"
 #include "shapes/shape.h"
 #include "shapes/textbox.h"
 #include "shapes/triangle.h"
+#include "util/assetLoader.h"
+#include "util/frameArena.h"
+#include "util/frameLimiter.h"
+#include "util/jobSystem.h"
+#include "util/objectPool.h"
 
 using std::vector, std::unique_ptr, std::make_unique, glm::ortho, glm::mat4,
     glm::vec3, glm::vec4;
 
+/// @brief How finished frames are presented to the window.
+enum class PresentMode
+{
+  /// @brief Wait for vertical blank (swap interval 1). Capped at the refresh
+  /// rate.
+  VSync,
+  /// @brief Present immediately (swap interval 0). May tear.
+  Immediate,
+  /// @brief Vsync when on time, tear instead of waiting a whole refresh when
+  /// late (swap interval -1, falls back to VSync if unsupported).
+  Adaptive
+};
+
+/**
+ * @brief Runtime options for the Engine, filled in from the command line in
+ * main.cpp.
+ */
+struct EngineConfig
+{
+  /// @brief Window swap interval behavior.
+  PresentMode presentMode = PresentMode::VSync;
+  /// @brief Cap the frame rate with a sleep-plus-spin limiter (0 for no cap).
+  double targetFps = 0.0;
+  /// @brief Render into an offscreen framebuffer on a surfaceless context
+  /// instead of a window. Time advances by a fixed step each frame so runs are
+  /// reproducible.
+  bool offscreen = false;
+  /// @brief Stop after this many frames (0 runs until closed).
+  unsigned int frameLimit = 0;
+  /// @brief Offscreen only: directory to write frame_NNNNN.png into after
+  /// every frame (empty to skip).
+  string frameDumpDir;
+  /// @brief Directory linked shader programs are cached in between runs
+  /// (empty to always compile from source).
+  string shaderCacheDir = "shader-cache";
+  /// @brief Recompile shaders when their files in res/shaders change (not
+  /// offscreen, where every run must render the same frames).
+  bool hotReloadShaders = true;
+  /// @brief Zero-allocation test mode: every frame after this many that
+  /// allocates on the heap is reported, and the run fails (0 doesn't check).
+  /// Only the frame's own thread counts, not the job system's workers.
+  /// Needs RUNNER_COUNT_ALLOCATIONS.
+  unsigned int allocationCheckAfter = 0;
+  /// @brief Play without a keyboard: the engine presses the menu and battle
+  /// keys and a Climber climbs the level (see game/autoplay.h).
+  bool autoplay = false;
+};
+
 /**
  * @brief The Engine class.
  * @details The Engine class is responsible for initializing the GLFW window,
  * loading shaders, and rendering the game state.
  */
-class Engine
+class Engine : public GameView
 {
 private:
   /// @brief The actual GLFW window.
+  /// @details Null when running offscreen on an EGL context.
   GLFWwindow *window{};
 
+  /// @brief Options the engine was started with.
+  EngineConfig config;
+
+  /// @brief Worker threads shared by every subsystem (see getJobs()).
+  JobSystem jobs;
+
+  /// @brief Text shader, fonts and creature table, decoded on the job system
+  /// and uploaded a slice per frame in render().
+  AssetLoader assets{jobs};
+
+  /// @brief Queues reloads of shaders whose files changed (hot reload).
+  void reloadChangedShaders();
+  /// @brief Hands a reloaded shader to everything holding a copy of it.
+  void shaderReloaded(const string &name, Shader &shader);
+
+  /// @brief Queues a font for background loading; onLoaded runs on the GL
+  /// thread with the uploaded glyphs.
+  void loadFontAsync(unsigned int fontSize,
+		     std::function<void(std::map<char, Character>)> onLoaded);
+
+  /// @brief Window-less context and the framebuffer rendered into when
+  /// config.offscreen is set.
+  unique_ptr<OffscreenContext> offscreenContext;
+  unique_ptr<Framebuffer> offscreenTarget;
+
+  /// @brief Number of frames presented so far.
+  unsigned long frameIndex = 0;
+
+  /// @brief Frames after config.allocationCheckAfter that allocated.
+  unsigned long allocatingFrames = 0;
+  /// @brief Reports the last frame if it allocated (zero-allocation test
+  /// mode, see EngineConfig::allocationCheckAfter).
+  void checkFrameAllocations();
+
+  /// @brief Frame rate cap, only created when config.targetFps is set.
+  unique_ptr<FrameLimiter> frameLimiter;
+
+  /// @brief Applies config.presentMode to the current window.
+  void applyPresentMode();
+
+  /// @brief Shows the finished frame: swaps the window buffers, or (offscreen)
+  /// optionally dumps the frame to a PNG.
+  void present();
+
   /// @brief The width and height of the window.
   const unsigned int width = 800, height = 600; // Window dimensions
 
@@ -44,50 +149,94 @@ private:
   const glm::mat4 projection =
       glm::ortho(0.0f, (float)width, 0.0f, (float)height);
 
+  /// @brief What part of the level is on screen; follows the player up and
+  /// down. World shapes are drawn with its view-projection, text and overlays
+  /// with the fixed PROJECTION.
+  Camera camera{static_cast<float>(width), static_cast<float>(height)};
+  /// @brief Platforms inside the camera's view this frame (reused so culling
+  /// doesn't allocate).
+  vector<const Rect *> visiblePlatforms;
+  /// @brief Keeps the camera inside the built part of the level.
+  void frameLevel();
+
   // Font renderer
   unique_ptr<FontRenderer> fontRenderer;
 
   // Shapes for this project
-  vector<unique_ptr<Rect>> platforms;
-  unique_ptr<Rect> goal;
+  /// @brief Platforms, streamed in chunks around the camera as the player
+  /// climbs (see game/levelStream.h).
+  unique_ptr<LevelStream> levels;
+  /// @brief Goal squares, recycled as the player climbs from goal to goal.
+  ObjectPool<Rect> goals;
+  /// @brief Null until the chunk it belongs to is built.
+  ObjectPool<Rect>::Handle goal;
+  /// @brief The goal after this one, placed as soon as its chunk is built so
+  /// reaching a goal only swaps handles.
+  ObjectPool<Rect>::Handle nextGoal;
+  /// @brief Takes a goal square from the pool and moves it to position.
+  ObjectPool<Rect>::Handle makeGoal(vec2 position);
+  /// @brief Chunk of the level the goal is (or will be) in.
+  size_t goalChunk = 0;
+  /// @brief Creates the goal and the one after once their chunks are built,
+  /// and moves them up if the player climbed past the goal.
+  void placeGoal();
   unique_ptr<Rect> user;
+  /// @brief Where the player would be after this frame's move, tested against
+  /// the level (kept so physics doesn't create a Rect every frame).
+  unique_ptr<Rect> nextPosRect;
 
   Shader shapeShader;
   Shader textShader;
+  /// @brief Shader for Circle and CircleBatch (signed distance circles).
+  Shader circleShader;
+  /// @brief Shader for the instanced clouds of the background.
+  Shader cloudShader;
+  /// @brief Drifting cloud layers behind the level.
+  unique_ptr<ParallaxBackground> background;
   // textbox that will be displayed throughout the game
   unique_ptr<Textbox> messageTextbox;
 
   double MouseX, MouseY;
 
-  // enemy that will be regenerated in engine.cpp logic. pointer for that reason
-  unique_ptr<enemy> currentEnemy;
-  // Same as currentEnemy
-  unique_ptr<entity> playerCharacter;
-
-  /*
-   * Holy mother of god...
-   *
-   * Trust me. ALL of these bolleans are necessary for the simple battle screen
-   * you see in this demo. These are FLAGS. nothing more. trying to track game
-   * states is not fun.
-   *
-   * Tried to be fairly verbose with the naming here
-   */
-  bool isPlayerTurn = false;
-  bool isEnemyTurn = false;
-  bool isBattling = false;
-  bool playerInAction = false;
-
-  bool battleTextDisplayed = false;
-  bool infoTextDisplayed = false;
-  bool enemyTextDisplayed = false;
-
-  bool playerAttacking = false;
-  bool playerDefending = false;
-  bool playerViewing = false;
-  bool playerRunning = false;
-
-  bool waitingForEnter = false;
+  /// @brief The player and the enemies in play: the one being fought
+  /// (session.opponent) and the one waiting at the next goal.
+  CombatRegistry combatants;
+  /// @brief The enemy for the next goal, spawned while the level is played
+  /// (see prefetchEnemy()).
+  CombatantId nextEnemy = noCombatant;
+  /// @brief Spawns nextEnemy, unless one is waiting or the creature table
+  /// isn't loaded yet.
+  void prefetchEnemy();
+  // Every creature in enemy_creatureinfo.csv, loaded through the AssetLoader
+  // so encounters don't read the file
+  vector<entityInfo> creatures;
+
+  /// @brief Game flow (menus and battles), see game/gameStateMachine.h.
+  GameSession session;
+  GameStateMachine game{gameStateTable(), GameState::Start};
+
+  /// @brief Climbs the level for config.autoplay (null otherwise).
+  unique_ptr<Climber> climber;
+  /// @brief Sets this frame's keys for config.autoplay: menu and battle keys
+  /// pressed every other frame, movement keys from the climber.
+  void pressAutoplayKeys();
+
+  /// @brief Keys whose current press was already turned into an event.
+  /// @details Events fire once per press, not once per frame while held.
+  bool keysHandled[1024];
+
+  /// @brief Player physics and goal collision (GameState::Play only).
+  void updatePlatforming();
+
+  /// @brief Performance overlay (toggled with F3).
+  bool showPerfHud = false;
+  /// @brief True while F3 is held so one press toggles the overlay once.
+  bool perfHudKeyHeld = false;
+  /// @brief Translucent panel drawn behind the overlay text.
+  unique_ptr<Rect> perfHudBackground;
+
+  /// @brief Draws frame time percentiles and per-frame counters from Metrics.
+  void renderPerfHud();
 
 public:
   /*
@@ -109,17 +258,19 @@ public:
 
   /// @brief Constructor for the Engine class.
   /// @details Initializes window and shaders.
-  Engine();
+  explicit Engine(const EngineConfig &config = EngineConfig());
 
   /// @brief Destructor for the Engine class.
   ~Engine();
 
-  /// @brief Initializes the GLFW window.
+  /// @brief Initializes the GLFW window, or the offscreen context and
+  /// framebuffer.
   /// @return 0 if successful, -1 otherwise.
   unsigned int initWindow(bool debug = false);
 
   /// @brief Loads shaders from files and stores them in the shaderManager.
-  /// @details Renderers are initialized here.
+  /// @details Renderers are initialized here. Only the shape shader is
+  /// loaded before returning; text rendering is queued on the AssetLoader.
   void initShaders();
 
   /// @brief Initializes the shapes to be rendered.
@@ -137,6 +288,33 @@ public:
   /// @details Displays/renders objects on the screen.
   void render();
 
+  /// @brief Sets a key's state directly.
+  /// @details Lets offscreen runs script input, since there is no window to
+  /// poll.
+  void setKey(int key, bool pressed);
+
+  /// @brief The engine's job system, for subsystems that want to run work on
+  /// worker threads.
+  JobSystem &getJobs() { return jobs; }
+
+  /// @brief Number of frames that failed the zero-allocation check (see
+  /// EngineConfig::allocationCheckAfter).
+  unsigned long getAllocatingFrames() const { return allocatingFrames; }
+
+  /// @brief Game flow state (for tests and tools driving the engine).
+  GameState getGameState() const { return game.getState(); }
+
+  /// @brief GameView: shows text in the message textbox.
+  void showMessage(const string &text, float scrollSpeed) override;
+  /// @brief GameView: closes the message textbox.
+  void hideMessage() override;
+  /// @brief GameView: rebuilds the level after a game over.
+  void resetLevel() override;
+
+  /// @brief Writes the current frame to a PNG file (offscreen only).
+  /// @return true if the file was written.
+  bool saveFrame(const string &path) const;
+
   /* deltaTime variables */
   float deltaTime = 0.0f; // Time between current frame and last frame
   float lastFrame = 0.0f; // Time of last frame (used to calculate deltaTime)
@@ -4,17 +4,27 @@
 #include <iostream>
 
 Font::Font(std::string fontPath, unsigned int fontSize) {
+    for (const GlyphBitmap &glyph : decode(fontPath, fontSize))
+        Characters.insert(std::pair<char, Character>(glyph.c, upload(glyph)));
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+std::vector<GlyphBitmap> Font::decode(const std::string &fontPath, unsigned int fontSize) {
+    std::vector<GlyphBitmap> glyphs;
     FT_Library ft;
 
-    // Initialize FreeType library
+    // Initialize FreeType library (one per call, so fonts can be decoded on several threads)
     if (FT_Init_FreeType(&ft)) {
         std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+        return glyphs;
     }
 
     // Load font as face
     FT_Face face;
     if (FT_New_Face(ft, fontPath.c_str(), 0, &face)) {
         std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        FT_Done_FreeType(ft);
+        return glyphs;
     }
 
     // Set size to load glyphs as
@@ -25,9 +35,8 @@ Font::Font(std::string fontPath, unsigned int fontSize) {
         std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
     }
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
-
     // Load first 128 characters of ASCII set
+    glyphs.reserve(128);
     for (unsigned char c = 0; c < 128; c++) {
         // load character glyph 
         if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
@@ -35,41 +44,49 @@ Font::Font(std::string fontPath, unsigned int fontSize) {
             continue;
         }
 
-        // generate texture
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-
-        // set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        // now store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            static_cast<unsigned int>(face->glyph->advance.x)
-        };
-        Characters.insert(std::pair<char, Character>(c, character));
+        // copy the bitmap out, FreeType reuses its buffer for the next glyph
+        const FT_Bitmap &bitmap = face->glyph->bitmap;
+        GlyphBitmap glyph;
+        glyph.c = static_cast<char>(c);
+        glyph.Size = glm::ivec2(bitmap.width, bitmap.rows);
+        glyph.Bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+        glyph.Advance = static_cast<unsigned int>(face->glyph->advance.x);
+        glyph.pixels.assign(bitmap.buffer, bitmap.buffer + bitmap.width * bitmap.rows);
+        glyphs.push_back(std::move(glyph));
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
 
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
+    return glyphs;
+}
+
+Character Font::upload(const GlyphBitmap &glyph) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+
+    // generate texture
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_RED,
+        glyph.Size.x,
+        glyph.Size.y,
+        0,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        glyph.pixels.empty() ? nullptr : glyph.pixels.data()
+    );
+
+    // set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // now store character for later use
+    return {texture, glyph.Size, glyph.Bearing, glyph.Advance};
 }
 
 std::map<char, Character> Font::getCharacters() const {
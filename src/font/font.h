@@ -3,6 +3,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 
 #include <glm/glm.hpp>
@@ -26,6 +27,18 @@ struct Character {
     unsigned int Advance;
 };
 
+/**
+ * @brief A rasterized glyph that hasn't been uploaded to a texture yet
+ * @details Produced by Font::decode, which doesn't touch OpenGL and so can run on any thread
+ */
+struct GlyphBitmap {
+    char c;
+    glm::ivec2 Size;
+    glm::ivec2 Bearing;
+    unsigned int Advance;
+    std::vector<unsigned char> pixels;
+};
+
 /**
  * @brief A font
  * @details This class is used to store information about a font
@@ -41,6 +54,23 @@ class Font {
         Font(std::string fontPath, unsigned int fontSize);
 
         
+        /**
+         * @brief Rasterize the first 128 ASCII characters with FreeType (no OpenGL calls)
+         *
+         * @param fontPath The path to the font file
+         * @param fontSize The size of the font
+         * @return one bitmap per character that loaded
+         */
+        static std::vector<GlyphBitmap> decode(const std::string &fontPath, unsigned int fontSize);
+
+        /**
+         * @brief Create the texture for a decoded glyph (needs the GL context)
+         *
+         * @param glyph The decoded glyph
+         * @return the character, ready to render
+         */
+        static Character upload(const GlyphBitmap &glyph);
+
         /**
          * @brief Get the characters
          * 
@@ -1,8 +1,12 @@
 #include "fontRenderer.h"
+#include "../render/streamBuffer.h"
+#include "../util/metrics.h"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <algorithm>
+
 FontRenderer::FontRenderer(Shader& shader, std::string fontPath, int fontSize) {
     this->shader = shader;
     this->initRenderData();
@@ -10,65 +14,91 @@ FontRenderer::FontRenderer(Shader& shader, std::string fontPath, int fontSize) {
     this->font = myFont.getCharacters();
 }
 
+FontRenderer::FontRenderer(Shader& shader) {
+    this->shader = shader;
+    this->initRenderData();
+}
+
+void FontRenderer::setFont(Shader& shader, std::map<char, Character> characters) {
+    this->shader = shader;
+    this->font = std::move(characters);
+}
+
 FontRenderer::~FontRenderer() {
     glDeleteVertexArrays(1, &this->VAO);
-    glDeleteBuffers(1, &this->VBO);
 }
 
 void FontRenderer::initRenderData() {
+    // Quads are streamed into the shared ring buffer, see render/streamBuffer.h
     glGenVertexArrays(1, &this->VAO);
-    glGenBuffers(1, &this->VBO);
     glBindVertexArray(this->VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, StreamBuffer::shared().getBuffer());
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void FontRenderer::renderText(std::string text, float x, float y, const glm::mat4 projection, float scale, glm::vec3 color) {
+void FontRenderer::renderText(std::string_view text, float x, float y, const glm::mat4 projection, float scale, glm::vec3 color) {
+    // Font still loading
+    if (font.empty() || text.empty())
+        return;
+
     // activate corresponding render state
 
     this->shader.use();
     glUniformMatrix4fv(glGetUniformLocation(this->shader.ID, "projection"), 1, false, glm::value_ptr(projection));
     glUniform3f(glGetUniformLocation(this->shader.ID, "textColor"), color.x, color.y, color.z);
+    Metrics::add(Metric::UniformsSet, 2);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(this->VAO);
-
-    // iterate through all characters
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        Character ch = font[*c];
+    // Write every glyph's quad with one map, so drawing never waits for a buffer update
+    const GLsizeiptr vertexSize = 4 * sizeof(float);
+    StreamBuffer &stream = StreamBuffer::shared();
+    float (*vertices)[4] = static_cast<float (*)[4]>(stream.map(text.size() * 6 * vertexSize, vertexSize));
+    if (!vertices)
+        return;
+    float cursor = x;
+    for (char c : text) {
+        const Character &ch = font[c];
 
-        float xpos = x + ch.Bearing.x * scale;
+        float xpos = cursor + ch.Bearing.x * scale;
         float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
 
         float w = ch.Size.x * scale;
         float h = ch.Size.y * scale;
-        // update VBO for each character
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 0.0f },            
+        const float quad[6][4] = {
+            { xpos,     ypos + h,   0.0f, 0.0f },
             { xpos,     ypos,       0.0f, 1.0f },
             { xpos + w, ypos,       1.0f, 1.0f },
 
             { xpos,     ypos + h,   0.0f, 0.0f },
             { xpos + w, ypos,       1.0f, 1.0f },
-            { xpos + w, ypos + h,   1.0f, 0.0f }           
+            { xpos + w, ypos + h,   1.0f, 0.0f }
         };
-        // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-        // update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        std::copy(&quad[0][0], &quad[0][0] + 24, &vertices[0][0]);
+        vertices += 6;
         // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-        x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
+        cursor += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
+    }
+    stream.unmap();
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(this->VAO);
+    Metrics::add(Metric::StateChanges, 2);
+
+    // iterate through all characters
+    GLint first = static_cast<GLint>(stream.getOffset() / vertexSize);
+    for (char c : text) {
+        // render glyph texture over quad
+        glBindTexture(GL_TEXTURE_2D, font[c].TextureID);
+        glDrawArrays(GL_TRIANGLES, first, 6);
+        first += 6;
+        Metrics::add(Metric::DrawCalls);
+        Metrics::add(Metric::Triangles, 2);
+        Metrics::add(Metric::StateChanges);
     }
 
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
+    Metrics::add(Metric::StateChanges, 2);
 }
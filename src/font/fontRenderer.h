@@ -5,6 +5,8 @@
 #include "../shader/shader.h"
 #include "font.h"
 
+#include <string_view>
+
 /**
  * @brief A font renderer
  * @details This class is used to render text using a font
@@ -21,6 +23,34 @@ class FontRenderer {
          */
         FontRenderer(Shader& shader, std::string fontPath, int fontSize);
 
+        /**
+         * @brief Construct a Font Renderer whose font arrives later (see setFont)
+         * @details Renders nothing until then
+         *
+         * @param shader The shader to use
+         */
+        explicit FontRenderer(Shader& shader);
+
+        /**
+         * @brief Sets the glyphs (and the shader, which may have been compiled since construction)
+         *
+         * @param shader The shader to use
+         * @param characters Uploaded characters, e.g. from Font::upload
+         */
+        void setFont(Shader& shader, std::map<char, Character> characters);
+
+        /**
+         * @brief Replaces the shader (e.g. after it was hot reloaded)
+         *
+         * @param shader The shader to use
+         */
+        void setShader(Shader& shader) { this->shader = shader; }
+
+        /**
+         * @brief Whether a font has been loaded
+         */
+        bool hasFont() const { return !font.empty(); }
+
         /**
          * @brief Destroy the Font Renderer object
          * @details destroys the VAO and VBO associated with the font renderer
@@ -30,14 +60,15 @@ class FontRenderer {
         /**
          * @brief Renders text on the screen
          * 
-         * @param text The text to render
+         * @param text The text to render (a view, so callers can pass a single character or a
+         * buffer without building a string)
          * @param x The x position of the text
          * @param y The y position of the text
          * @param projection The projection matrix
          * @param scale The scale of the text
          * @param color The color of the text
          */
-        void renderText(std::string text, float x, float y, const glm::mat4 projection, float scale, glm::vec3 color);
+        void renderText(std::string_view text, float x, float y, const glm::mat4 projection, float scale, glm::vec3 color);
 
     private:
         /**
@@ -46,9 +77,9 @@ class FontRenderer {
         Shader shader;
 
         /**
-         * @brief The VAO and VBO associated with the font renderer
+         * @brief The VAO associated with the font renderer (vertices come from StreamBuffer::shared())
          */
-        GLuint VAO, VBO;
+        GLuint VAO;
 
         /**
          * @brief A set of character structs mapped to their ASCII character representations
@@ -0,0 +1,220 @@
+#include "autoplay.h"
+
+#include <cmath>
+
+namespace {
+    /// @brief Gap left between the player and a platform's side when heading for it.
+    const float asideMargin = 3.0f;
+    /// @brief Jumps from one platform that may miss the same target before it is avoided.
+    const int maxMisses = 3;
+    /// @brief Frames a simulated jump may take before it counts as a miss.
+    const int maxJumpFrames = 180;
+    /// @brief Frames without getting higher before the level counts as a dead end (10 seconds).
+    const int patience = 600;
+
+    bool holds(const Rect &platform, const Rect &square) {
+        // The square sits on the platform (a goal is placed 5 pixels above its platform's top)
+        const float above = square.getBottom() - platform.getTop();
+        return above >= 0 && above < 20 && square.getPos().x >= platform.getLeft() &&
+               square.getPos().x <= platform.getRight();
+    }
+
+    void walkTowards(float x, float to, float step, ClimbKeys &keys) {
+        // Half a step either way, so a walk along the step grid stops exactly on to
+        if (to > x + step / 2)
+            keys.right = true;
+        else if (to < x - step / 2)
+            keys.left = true;
+    }
+}
+
+Climber::Climber(float moveSpeed, float jumpForce, float gravity)
+    : moveSpeed(moveSpeed), jumpForce(jumpForce), gravity(gravity), step(moveSpeed / 60.0f) {}
+
+void Climber::reset() {
+    hasTarget = false;
+    jumping = false;
+    misses = 0;
+    avoided = 0;
+    highest = 0;
+    sinceHigher = 0;
+    leaving = false;
+}
+
+ClimbKeys Climber::update(const Rect &player, bool onGround, const vector<Rect *> &platforms,
+                          const Rect *goal) {
+    ClimbKeys keys;
+    const float x = player.getPos().x;
+
+    if (player.getBottom() > highest + 1) {
+        highest = player.getBottom();
+        sinceHigher = 0;
+    }
+    else if (++sinceHigher > patience) {
+        leaving = true;
+    }
+
+    if (!onGround) {
+        if (jumping && hasTarget)
+            steer(x, player.getBottom(), keys);
+        return keys;
+    }
+
+    Box standing;
+    if (findSupport(player, platforms, standing)) {
+        if (avoided != 0 && standing.top > avoided + 1)
+            avoided = 0;
+        if (jumping) {
+            jumping = false;
+            const bool sameSupport = std::fabs(standing.top - support.top) < 1 &&
+                                     std::fabs(standing.left - support.left) < 1;
+            if (hasTarget && sameSupport && ++misses >= maxMisses) {
+                avoided = target.top;
+                hasTarget = false;
+                misses = 0;
+            }
+            else if (!sameSupport) {
+                // Somewhere new (the target or not), so plan from here
+                hasTarget = false;
+                misses = 0;
+            }
+        }
+        support = standing;
+    }
+
+    if (leaving) {
+        // Stuck: walk off the left of every platform and then the ground, falling out of the
+        // level, which starts a new one
+        walkTowards(x, support.left - player.getSize().x, step, keys);
+        return keys;
+    }
+
+    // A goal on this platform is worth more than climbing on
+    for (const Rect *platform : platforms) {
+        if (goal && std::fabs(platform->getTop() - support.top) < 1 &&
+            platform->getLeft() <= x && platform->getRight() >= x && holds(*platform, *goal)) {
+            walkTowards(x, goal->getPos().x, step, keys);
+            return keys;
+        }
+    }
+
+    if (!hasTarget && !chooseTarget(player, platforms, goal)) {
+        // Nothing reachable from here: drop off the end nearer the goal and try from below
+        avoided = support.top;
+        const float middle = (support.left + support.right) / 2;
+        if (goal && goal->getPos().x < middle)
+            walkTowards(x, support.left - player.getSize().x, step, keys);
+        else
+            walkTowards(x, support.right + player.getSize().x, step, keys);
+        return keys;
+    }
+
+    walkTowards(x, launch, step, keys);
+    if (!keys.left && !keys.right) {
+        keys.jump = true;
+        jumping = true;
+        steer(x, player.getBottom(), keys);
+    }
+    return keys;
+}
+
+void Climber::steer(float x, float feet, ClimbKeys &keys) const {
+    if (feet > target.top + 1)
+        walkTowards(x, (target.left + target.right) / 2, step, keys);
+    else
+        walkTowards(x, aside, step, keys);
+}
+
+bool Climber::findSupport(const Rect &player, const vector<Rect *> &platforms, Box &found) const {
+    for (const Rect *platform : platforms) {
+        if (std::fabs(platform->getTop() - player.getBottom()) < 2 &&
+            platform->getRight() >= player.getLeft() && platform->getLeft() <= player.getRight()) {
+            found = {platform->getLeft(), platform->getRight(), platform->getTop(),
+                     platform->getBottom()};
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Climber::chooseTarget(const Rect &player, const vector<Rect *> &platforms, const Rect *goal) {
+    const float x = player.getPos().x;
+    const float feet = player.getBottom();
+    const vec2 size = player.getSize();
+    const float reach = jumpForce * jumpForce / (2 * gravity);
+    // Spots on the step grid the walk stops at, anywhere the player still stands on support
+    const int first = static_cast<int>(std::ceil((support.left - size.x / 2 + 1 - x) / step));
+    const int last = static_cast<int>(std::floor((support.right + size.x / 2 - 1 - x) / step));
+
+    bool found = false;
+    bool foundGoal = false;
+    Box best{};
+    float bestAside = 0, bestLaunch = 0;
+    for (const Rect *platform : platforms) {
+        const float rise = platform->getTop() - feet;
+        if (rise < 5 || rise > reach)
+            continue;
+        if (avoided != 0 && std::fabs(platform->getTop() - avoided) < 1)
+            continue;
+        // The goal's platform first, then the highest, then the nearest jump
+        const bool isGoal = goal && holds(*platform, *goal);
+        if (found && ((foundGoal && !isGoal) ||
+                      (foundGoal == isGoal && platform->getTop() < best.top)))
+            continue;
+        // Ranked the same as the best so far: only a nearer jump is better
+        bool nearerOnly = found && foundGoal == isGoal && platform->getTop() == best.top;
+
+        target = {platform->getLeft(), platform->getRight(), platform->getTop(),
+                  platform->getBottom()};
+        for (const float side : {target.left - size.x / 2 - asideMargin,
+                                 target.right + size.x / 2 + asideMargin}) {
+            aside = side;
+            for (int i = first; i <= last; i++) {
+                const float from = x + i * step;
+                if (nearerOnly && std::fabs(from - x) >= std::fabs(bestLaunch - x))
+                    continue;
+                if (!lands(from, feet, size, platforms))
+                    continue;
+                found = true;
+                foundGoal = isGoal;
+                best = target;
+                bestAside = side;
+                bestLaunch = from;
+                nearerOnly = true;
+            }
+        }
+    }
+    hasTarget = found;
+    if (found) {
+        target = best;
+        aside = bestAside;
+        launch = bestLaunch;
+    }
+    return found;
+}
+
+bool Climber::lands(float x, float feet, vec2 size, const vector<Rect *> &platforms) const {
+    const float dt = 1.0f / 60.0f;
+    vec2 pos(x, feet + size.y / 2);
+    vec2 velocity(0, jumpForce);
+    for (int frame = 0; frame < maxJumpFrames; frame++) {
+        ClimbKeys keys;
+        steer(pos.x, pos.y - size.y / 2, keys);
+        velocity.x = keys.left ? -moveSpeed : keys.right ? moveSpeed : 0;
+        velocity.y -= gravity * dt;
+        const vec2 next = pos + velocity * dt;
+        // Anything but landing on target (bumping a head or a side, landing elsewhere) is a miss
+        for (const Rect *platform : platforms) {
+            if (next.x + size.x / 2 < platform->getLeft() ||
+                next.x - size.x / 2 > platform->getRight() ||
+                next.y - size.y / 2 > platform->getTop() ||
+                next.y + size.y / 2 < platform->getBottom())
+                continue;
+            return velocity.y < 0 && pos.y > platform->getPos().y &&
+                   std::fabs(platform->getTop() - target.top) < 1 &&
+                   std::fabs(platform->getLeft() - target.left) < 1;
+        }
+        pos = next;
+    }
+    return false;
+}
@@ -0,0 +1,85 @@
+#ifndef AUTOPLAY_H
+#define AUTOPLAY_H
+
+#include <vector>
+
+#include "../shapes/rect.h"
+
+using std::vector;
+
+/*
+ * Scripted play for runs without a player at the keyboard (--autoplay, e.g. the allocation check):
+ * the Engine presses the menu and battle keys itself and asks a Climber which movement keys to
+ * hold while platforming. Only reads the level, so it works on any layout the level stream makes.
+ */
+
+/// @brief Movement keys to hold for one frame.
+struct ClimbKeys {
+    bool left = false;
+    bool right = false;
+    bool jump = false;
+};
+
+/**
+ * @brief Climbs a level by jumping from platform to platform, visiting goals on the way.
+ * @details Standing on a platform, it tries jumps to every platform above within reach: from each
+ * spot on the platform it can walk to, heading for one side of the target and steering onto it
+ * once above it. A jump is only taken if stepping it through the engine's physics (a 60th of a
+ * second per frame, as offscreen runs use) lands on the target; the goal's platform is preferred,
+ * then the highest. A goal on the platform it stands on is walked to first. When nothing above is
+ * reachable it walks off the end nearer the goal and avoids the dead end until it is higher up; if
+ * it gets no higher for a while it walks out of the level so the engine starts a new one.
+ */
+class Climber {
+public:
+    /// @param moveSpeed Horizontal speed while a direction is held
+    /// @param jumpForce Initial upwards velocity of a jump
+    /// @param gravity Downwards acceleration
+    Climber(float moveSpeed, float jumpForce, float gravity);
+
+    /// @brief Keys to hold this frame.
+    /// @param player The player's rect
+    /// @param onGround Whether the player stands on a platform
+    /// @param platforms The platforms of the level
+    /// @param goal The goal square, or null if there is none
+    ClimbKeys update(const Rect &player, bool onGround, const vector<Rect *> &platforms,
+                     const Rect *goal);
+
+    /// @brief Forgets the current plan (e.g. after the level was rebuilt).
+    void reset();
+
+private:
+    /// @brief Platform edges, copied: platforms are recycled once they fall out of the level.
+    struct Box {
+        float left, right, top, bottom;
+    };
+
+    float moveSpeed, jumpForce, gravity;
+    /// @brief Pixels per frame at 60 fps: how far a held key moves the player each frame.
+    float step;
+
+    bool hasTarget = false;
+    Box target{};
+    /// @brief Where the jump to target starts, and the side of target it heads for until above it.
+    float launch = 0;
+    float aside = 0;
+    bool jumping = false;
+    /// @brief The platform last stood on, and failed jumps from it.
+    Box support{};
+    int misses = 0;
+    /// @brief Top of a platform not to aim for again until higher up (0 for none).
+    float avoided = 0;
+    /// @brief Highest the feet have been, frames since, and whether it gave up on the level.
+    float highest = 0;
+    int sinceHigher = 0;
+    bool leaving = false;
+
+    /// @brief Direction to hold in the air: towards aside until above target, then onto it.
+    void steer(float x, float feet, ClimbKeys &keys) const;
+    bool findSupport(const Rect &player, const vector<Rect *> &platforms, Box &found) const;
+    bool chooseTarget(const Rect &player, const vector<Rect *> &platforms, const Rect *goal);
+    /// @brief Whether jumping from x (with feet on the support) while steering lands on target.
+    bool lands(float x, float feet, vec2 size, const vector<Rect *> &platforms) const;
+};
+
+#endif //AUTOPLAY_H
@@ -0,0 +1,77 @@
+#include "battleLog.h"
+
+#include <algorithm>
+#include <charconv>
+
+BattleLog::BattleLog(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+    events.resize(size);
+    mask = size - 1;
+}
+
+void BattleLog::format(uint64_t first, const CombatRegistry &registry, std::string &out) const {
+    const uint64_t start = std::max(first, oldest());
+    for (uint64_t sequence = start; sequence < total; ++sequence) {
+        if (sequence != start)
+            out += '\n';
+        formatBattleEvent(at(sequence), registry, out);
+    }
+}
+
+namespace {
+    void appendDamage(int damage, std::string &out) {
+        char digits[16];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), damage);
+        out.append(digits, result.ptr);
+        out += " damage!";
+    }
+}
+
+void formatBattleEvent(const BattleEvent &event, const CombatRegistry &registry, std::string &out) {
+    const std::string &actor = registry.getName(event.actor);
+    const std::string &target = registry.getName(event.target);
+    switch (event.action) {
+        case battleAction::Attack:
+            out += actor;
+            out += " is attacking!\n";
+            if (event.critical)
+                out += "Critical Hit! ";
+            out += target;
+            out += " received ";
+            appendDamage(event.damage, out);
+            break;
+        case battleAction::Fumble:
+            out += actor;
+            out += " is attacking!\nCritical Failure! ";
+            out += target;
+            out += " received ";
+            appendDamage(event.damage, out);
+            break;
+        case battleAction::Blocked:
+            out += actor;
+            out += " is attacking!\n";
+            out += target;
+            out += " defended the attack.";
+            break;
+        case battleAction::DefenseBroken:
+            out += actor;
+            out += " is attacking!\n";
+            out += actor;
+            out += " broke through the defense, ";
+            out += target;
+            out += " is prone!";
+            break;
+        case battleAction::Defend:
+            out += actor;
+            out += " is defending!";
+            break;
+        case battleAction::DefendFailed:
+            out += actor;
+            out += " is defending!\nFailed to defend! ";
+            out += actor;
+            out += " is now exposed";
+            break;
+    }
+}
@@ -0,0 +1,82 @@
+//
+// Structured record of what happened in battle.
+//
+
+#ifndef BATTLE_LOG_H
+#define BATTLE_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "combatRegistry.h"
+
+/// @brief Kinds of combat events.
+enum class battleAction : uint8_t {
+    Attack,        // Hit the target for damage (critical hits set BattleEvent::critical)
+    Fumble,        // Critical failure: hit the target for reduced damage
+    Blocked,       // Target was defending, no damage
+    DefenseBroken, // Target was defending, their defense broke and left them prone
+    Defend,        // Actor raised their defense
+    DefendFailed   // Actor tried to defend and was left exposed
+};
+
+/// @brief One thing that happened in battle. Plain data, no text or pointers, so it can be kept
+/// or saved as is.
+struct BattleEvent {
+    /// @brief Names of who acted and who it was against. Interned names stay in the registry after
+    /// the combatants are gone, so an event keeps its names when its ids are reused.
+    NameHandle actor{};
+    NameHandle target{};
+    battleAction action = battleAction::Attack;
+    bool critical = false;
+    int damage = 0;
+};
+
+/**
+ * @brief Fixed-capacity ring buffer of BattleEvents.
+ * @details Storage is allocated once in the constructor; when full the oldest events are
+ * overwritten. Every event gets a sequence number (count() before it was pushed) so callers can
+ * remember where a turn started and format just that turn later. Nothing is turned into text until
+ * format() is called, so headless simulations never pay for it.
+ */
+class BattleLog {
+public:
+    /// @param capacity Events kept, rounded up to a power of two.
+    explicit BattleLog(size_t capacity = 256);
+
+    void push(const BattleEvent &event) {
+        events[static_cast<size_t>(total) & mask] = event;
+        ++total;
+    }
+
+    /// @brief Number of events pushed since construction or clear() (the next sequence number).
+    uint64_t count() const { return total; }
+
+    /// @brief Sequence number of the oldest event still stored.
+    uint64_t oldest() const { return total > events.size() ? total - events.size() : 0; }
+
+    /// @brief The event with the given sequence number (between oldest() and count() - 1).
+    const BattleEvent &at(uint64_t sequence) const {
+        return events[static_cast<size_t>(sequence) & mask];
+    }
+
+    /// @brief Forgets all events (keeps the storage).
+    void clear() { total = 0; }
+
+    /// @brief Appends the text of events [first, count()) to out, one line per sentence.
+    /// @details Events older than oldest() have been overwritten and are skipped. Names are looked
+    /// up in the registry the events were recorded from.
+    void format(uint64_t first, const CombatRegistry &registry, std::string &out) const;
+
+private:
+    std::vector<BattleEvent> events;
+    size_t mask;
+    uint64_t total = 0;
+};
+
+/// @brief Appends the text for one event to out.
+void formatBattleEvent(const BattleEvent &event, const CombatRegistry &registry, std::string &out);
+
+#endif //BATTLE_LOG_H
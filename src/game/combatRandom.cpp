@@ -0,0 +1,19 @@
+#include "combatRandom.h"
+
+#include <random>
+
+namespace {
+    // minstd is a single multiply and modulo per roll, plenty for dice
+    std::minstd_rand &generator() {
+        thread_local std::minstd_rand engine(std::random_device{}());
+        return engine;
+    }
+}
+
+void seedCombatRandom(unsigned int seed) {
+    generator().seed(seed);
+}
+
+int combatRandom(int n) {
+    return static_cast<int>(generator()() % static_cast<unsigned int>(n));
+}
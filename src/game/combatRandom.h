@@ -0,0 +1,20 @@
+//
+// Random numbers for combat rolls.
+//
+
+#ifndef COMBAT_RANDOM_H
+#define COMBAT_RANDOM_H
+
+/*
+ * Every thread has its own generator, so battles can be simulated on many threads at once without
+ * sharing (or locking) rand()'s global state. Generators start from a random seed; call
+ * seedCombatRandom() for a reproducible sequence.
+ */
+
+/// @brief Reseeds the calling thread's combat generator.
+void seedCombatRandom(unsigned int seed);
+
+/// @brief A roll in [0, n) from the calling thread's generator (use like rand() % n).
+int combatRandom(int n);
+
+#endif //COMBAT_RANDOM_H
@@ -0,0 +1,171 @@
+#include "combatRegistry.h"
+#include "battleLog.h"
+#include "enemy.h"
+
+#include <cassert>
+
+CombatantId CombatRegistry::create() {
+    if (!freeIds.empty()) {
+        CombatantId id = freeIds.back();
+        freeIds.pop_back();
+        return id;
+    }
+    return nextId++;
+}
+
+void CombatRegistry::destroy(CombatantId id) {
+    health.remove(id);
+    power.remove(id);
+    alignment.remove(id);
+    status.remove(id);
+    side.remove(id);
+    names.remove(id);
+    freeIds.push_back(id);
+}
+
+CombatantId CombatRegistry::spawn(const entityInfo &info, CombatSide combatSide) {
+    CombatantId id = create();
+    health.insert(id, {info.health, info.health});
+    // Experience is kept in whole points, as entity does
+    power.insert(id, {static_cast<float>(static_cast<int>(info.experience) / 10)});
+    alignment.insert(id, {info.alignment});
+    status.insert(id, {combatStatus::None});
+    side.insert(id, {combatSide});
+    names.insert(id, internName(info.name, info.description));
+    return id;
+}
+
+NameHandle CombatRegistry::internName(const std::string &name, const std::string &description) {
+    auto found = nameLookup.find(name);
+    if (found != nameLookup.end())
+        return {found->second};
+    uint32_t index = static_cast<uint32_t>(nameTable.size());
+    nameTable.push_back(name);
+    descriptionTable.push_back(description);
+    nameLookup.emplace(name, index);
+    return {index};
+}
+
+void CombatRegistry::reserve(size_t count) {
+    health.reserve(count);
+    power.reserve(count);
+    alignment.reserve(count);
+    status.reserve(count);
+    side.reserve(count);
+    names.reserve(count);
+}
+
+void CombatRegistry::clear() {
+    health.clear();
+    power.clear();
+    alignment.clear();
+    status.clear();
+    side.clear();
+    names.clear();
+    freeIds.clear();
+    nextId = 0;
+}
+
+namespace {
+    // One enemy move (attack or defend) by self against the target, given their components
+    int enemyMove(NameHandle self, const Health &selfHealth, float selfPower, Status &selfStatus,
+                  NameHandle target, Health &targetHealth, Status &targetStatus, BattleLog &log) {
+        if (enemyChoosesAttack(selfHealth.current, selfHealth.base, targetStatus.value)) {
+            enemyAttackRoll roll = rollEnemyAttack(selfPower, targetStatus.value);
+            targetHealth.current -= roll.damage;
+            targetStatus.value = roll.targetStatus;
+            if (roll.action != battleAction::Blocked)
+                selfStatus.value = combatStatus::Attacking;
+            log.push({self, target, roll.action, roll.critical, roll.damage});
+            return roll.damage;
+        }
+        // A failed defense leaves the defender exposed
+        if (enemyDefenseFails()) {
+            log.push({self, target, battleAction::DefendFailed});
+            selfStatus.value = combatStatus::Prone;
+        } else {
+            log.push({self, target, battleAction::Defend});
+            selfStatus.value = combatStatus::Defending;
+        }
+        return 0;
+    }
+}
+
+void attackAgainst(CombatRegistry &registry, CombatantId actor, CombatantId target, int damage,
+                   BattleLog &log) {
+    const NameHandle actorName = registry.names.get(actor);
+    const NameHandle targetName = registry.names.get(target);
+    if ((registry.status.get(target).value & combatStatus::Defending) != combatStatus::None) {
+        log.push({actorName, targetName, battleAction::Blocked});
+        return;
+    }
+    registry.health.get(target).current -= damage;
+    log.push({actorName, targetName, battleAction::Attack, false, damage});
+    registry.status.get(actor).value = combatStatus::Attacking;
+}
+
+void defendAgainst(CombatRegistry &registry, CombatantId actor, CombatantId target,
+                   BattleLog &log) {
+    registry.status.get(actor).value = combatStatus::Defending;
+    log.push({registry.names.get(actor), registry.names.get(target), battleAction::Defend});
+}
+
+void enemyMoveAgainst(CombatRegistry &registry, CombatantId actor, CombatantId target,
+                      BattleLog &log) {
+    enemyMove(registry.names.get(actor), registry.health.get(actor),
+              registry.power.get(actor).value, registry.status.get(actor),
+              registry.names.get(target), registry.health.get(target), registry.status.get(target),
+              log);
+}
+
+int runEnemyTurns(CombatRegistry &registry, CombatantId target, BattleLog &log) {
+    assert(registry.health.size() == registry.power.size() &&
+           registry.health.size() == registry.status.size() &&
+           registry.health.size() == registry.side.size() &&
+           registry.health.size() == registry.names.size());
+    // The target is looked up once; everyone else is visited by slot, in step across the arrays
+    Health &targetHealth = registry.health.get(target);
+    Status &targetStatus = registry.status.get(target);
+    const NameHandle targetName = registry.names.get(target);
+    const NameHandle *names = registry.names.data();
+    const Health *healths = registry.health.data();
+    const Power *powers = registry.power.data();
+    const Side *sides = registry.side.data();
+    Status *statuses = registry.status.data();
+    int totalDamage = 0;
+    for (size_t i = 0; i < registry.health.size(); ++i) {
+        if (sides[i].value != CombatSide::Enemy || healths[i].current <= 0)
+            continue;
+        totalDamage += enemyMove(names[i], healths[i], powers[i].value, statuses[i], targetName,
+                                 targetHealth, targetStatus, log);
+    }
+    return totalDamage;
+}
+
+size_t attackAllEnemies(CombatRegistry &registry, int damage) {
+    size_t hits = 0;
+    Health *healths = registry.health.data();
+    const Status *statuses = registry.status.data();
+    const Side *sides = registry.side.data();
+    for (size_t i = 0; i < registry.health.size(); ++i) {
+        if (sides[i].value != CombatSide::Enemy || healths[i].current <= 0 ||
+            (statuses[i].value & combatStatus::Defending) != combatStatus::None)
+            continue;
+        healths[i].current -= damage;
+        ++hits;
+    }
+    return hits;
+}
+
+size_t removeDefeated(CombatRegistry &registry) {
+    size_t removed = 0;
+    // Backwards, so the swap-and-pop in destroy() only moves entries that were already checked
+    for (size_t i = registry.health.size(); i-- > 0;) {
+        if (registry.side.data()[i].value == CombatSide::Enemy &&
+            registry.health.data()[i].current <= 0) {
+            registry.destroy(registry.health.ids()[i]);
+            ++removed;
+        }
+    }
+    return removed;
+}
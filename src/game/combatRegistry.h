@@ -0,0 +1,152 @@
+//
+// Component storage for many simultaneous combatants.
+//
+
+#ifndef COMBAT_REGISTRY_H
+#define COMBAT_REGISTRY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "entity.h"
+#include "../util/componentArray.h"
+
+class BattleLog;
+
+/*
+ * Everything that fights (the player, the opponent of the battle screen, and crowds of creatures)
+ * is a combatant in a CombatRegistry. Instead of one object per creature carrying its own name and
+ * description strings, every combat property is kept in its own dense array, so a system touching
+ * health and power for thousands of creatures walks a few contiguous arrays. Combatants are plain
+ * ids; names are interned once and referred to by handle.
+ */
+
+/// @brief Combatant id: an index into the registry's component arrays.
+using CombatantId = uint32_t;
+
+/// @brief Id of no combatant.
+const CombatantId noCombatant = UINT32_MAX;
+
+/// @brief Which side a combatant fights on.
+enum class CombatSide : uint8_t {
+    Player,
+    Enemy
+};
+
+struct Health {
+    float current;
+    float base;
+};
+
+/// @brief Attack strength of an enemy: its experience / 10 (in whole experience points).
+struct Power {
+    float value;
+};
+
+/// @brief -1 evil, 0 neutral, 1 good.
+struct Alignment {
+    int value;
+};
+
+struct Status {
+    combatStatus value;
+};
+
+struct Side {
+    CombatSide value;
+};
+
+/// @brief Index of an interned name/description pair (see CombatRegistry::internName).
+struct NameHandle {
+    uint32_t index;
+};
+
+/**
+ * @brief Owns the combatant ids and one ComponentArray per component type.
+ * @details Every combatant has every component: spawn() adds them all and destroy() removes them
+ * all, so the arrays hold the same combatants in the same order and slot i of each belongs to
+ * ids()[i]. Systems walk the arrays side by side by slot, and use get() only for a combatant named
+ * by id. Systems may change component values, but never insert into or remove from the arrays
+ * directly.
+ */
+class CombatRegistry {
+public:
+    ComponentArray<Health> health;
+    ComponentArray<Power> power;
+    ComponentArray<Alignment> alignment;
+    ComponentArray<Status> status;
+    ComponentArray<Side> side;
+    ComponentArray<NameHandle> names;
+
+    /// @brief Creates a combatant from an entity-data row. Reuses ids of destroyed combatants.
+    CombatantId spawn(const entityInfo &info, CombatSide combatSide);
+
+    /// @brief Removes a combatant and all its components.
+    void destroy(CombatantId id);
+
+    /// @brief Stores a name and description once, returning the existing handle for a known name.
+    NameHandle internName(const std::string &name, const std::string &description);
+
+    const std::string &getName(NameHandle handle) const { return nameTable[handle.index]; }
+    const std::string &getDescription(NameHandle handle) const {
+        return descriptionTable[handle.index];
+    }
+    /// @brief Name and description of a live combatant.
+    const std::string &getName(CombatantId id) const { return getName(names.get(id)); }
+    const std::string &getDescription(CombatantId id) const {
+        return getDescription(names.get(id));
+    }
+
+    /// @brief Number of live combatants.
+    size_t size() const { return nextId - freeIds.size(); }
+
+    /// @brief Reserves room for count combatants in every component array.
+    void reserve(size_t count);
+
+    /// @brief Destroys every combatant (interned names are kept).
+    void clear();
+
+private:
+    CombatantId nextId = 0;
+    std::vector<CombatantId> freeIds;
+    std::vector<std::string> nameTable;
+    std::vector<std::string> descriptionTable;
+    std::unordered_map<std::string, uint32_t> nameLookup;
+
+    /// @brief A destroyed combatant's id if one is waiting for reuse, otherwise a new one.
+    CombatantId create();
+};
+
+/*
+ * Combat systems, recording what happened in a BattleLog. The one-on-one moves act on combatants
+ * named by id; the crowd systems walk the component arrays by slot. The enemy rules are the
+ * functions in enemy.h.
+ */
+
+/// @brief actor hits target for damage, unless the target is defending (the player's attack).
+void attackAgainst(CombatRegistry &registry, CombatantId actor, CombatantId target, int damage,
+                   BattleLog &log);
+
+/// @brief actor raises its defense against target (the player's defend).
+void defendAgainst(CombatRegistry &registry, CombatantId actor, CombatantId target,
+                   BattleLog &log);
+
+/// @brief actor makes an enemy's move against target: attack or defend, see enemyChoosesAttack().
+void enemyMoveAgainst(CombatRegistry &registry, CombatantId actor, CombatantId target,
+                      BattleLog &log);
+
+/// @brief Every living enemy makes its move against one target (a multi-enemy battle turn).
+/// @return Total damage dealt to the target.
+int runEnemyTurns(CombatRegistry &registry, CombatantId target, BattleLog &log);
+
+/// @brief Hits every living enemy for damage (skipping defenders, like attackAgainst()).
+/// @return Number of combatants hit.
+size_t attackAllEnemies(CombatRegistry &registry, int damage);
+
+/// @brief Destroys every enemy whose health has dropped to zero or below.
+/// @return Number of combatants removed.
+size_t removeDefeated(CombatRegistry &registry);
+
+#endif //COMBAT_REGISTRY_H
@@ -5,31 +5,30 @@
 #ifndef ENEMY_H
 #define ENEMY_H
 
+#include "battleLog.h"
 #include "entity.h"
 
-//Class enemy is-a entity, inherits parent class
-class enemy:public entity
-{
-	public:
-	//Constructor for child class, will use default parent
-	enemy();
-	//Overriding generateEntity() for polymorphism
-	void generateEntity() override;
-
-	//Actions to be called in move_against()
-	string attackAgainst(entity &pTarget);
-	string defendAgainst(entity &pTarget);
-
-	//This will be a move taken against a pTarget refernce
-	string move_against(entity &pTarget);
-
-protected:
-
-	//For new attacking methods
-	float fPower;
-
+/*
+ * Enemy combat rules as plain functions of the numbers involved, applied to combatants by the
+ * combat systems in combatRegistry.h
+ */
+
+//Outcome of one enemy attack: what to log and what the target's status becomes
+struct enemyAttackRoll {
+	battleAction action;
+	bool critical;
+	int damage;
+	combatStatus targetStatus;
 };
 
+//Rolls an attack with the given power against a target with the given status
+enemyAttackRoll rollEnemyAttack(float pPower, combatStatus pTargetStatus);
+
+//true to attack, false to defend: always attack a prone target, 50/50 when under half health,
+//otherwise 75/25
+bool enemyChoosesAttack(float pHealth, float pBaseHealth, combatStatus pTargetStatus);
 
+//true if an attempt to defend fails (1%), leaving the defender prone
+bool enemyDefenseFails();
 
 #endif //ENEMY_H
@@ -7,6 +7,8 @@
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <sstream>
+#include <utility>
 using namespace std;
 
 /*
@@ -24,7 +26,7 @@ entity::entity(float pHealth, float pExperience, string pName, string pDescripti
     generateEntity(pHealth, pExperience, pName, pDescription, pAlignment);
 }
 /*
- * Generates null entity on base call for later demonstration of overriding
+ * Generates null entity on base call
  */
 void entity::generateEntity() {
 
@@ -46,24 +48,24 @@ void entity::generateEntity(float pHealth, float pExperience, string pName, stri
 
 
 // Basic implementation of getters, descriptive names for easy reading
-float entity::getHealth() {
+float entity::getHealth() const {
     return fHealth;
 }
 
-int entity::getExperience() {
+int entity::getExperience() const {
     return fExperience;
 }
 
 
-string entity::getName() {
+const string &entity::getName() const {
     return fName;
 }
 
-string entity::getDescription() {
+const string &entity::getDescription() const {
     return fDescription;
 }
 
-int entity::getAlignment() {
+int entity::getAlignment() const {
     return fAlignment;
 }
 
@@ -81,55 +83,78 @@ void entity::addExperience(int pExperience) {
 }
 
 void entity::setName(string pName) {
-    fName = pName;
+    fName = std::move(pName);
 }
 
 void entity::setDescription(string pDescription) {
-    fDescription = pDescription;
+    fDescription = std::move(pDescription);
 }
 
 void entity::setAlignment(int pAlignment) {
     fAlignment = pAlignment;
 }
 
-/*
- *Sets status to defending, overriden in child class
- */
-string entity::defendAgainst(entity &pTaraget) {
-    this->setStatus("Defending");
-    return "Defending!";
-}
-
-/*
- * void attackAgainst() takes in a reference to an entity and a integer value to lower attack
- *
- * Checks to see if the other entity is "Defending" if not, lower health and announce damage.
- */
-string entity::attackAgainst(entity &pTarget, int pLowerBy){
-    string str;
-    if(pTarget.getStatus().compare("Defending")) {
-        pTarget.setHealth(pTarget.getHealth()-pLowerBy);
-        str = pTarget.getName() +" received " +to_string(pLowerBy) + " damage!";
-        this->setStatus("Attacking");
-    }
-    else {
-        str = ".. Creature defended attack!";
-    }
-    return str;
-}
-
 //Set methods for new fields
-void entity::setStatus(string pStatus) {
+void entity::setStatus(combatStatus pStatus) {
     this->fStatus = pStatus;
 }
-string entity::getStatus() {
+combatStatus entity::getStatus() const {
     return this->fStatus;
 }
+bool entity::hasStatus(combatStatus pStatus) const {
+    return (this->fStatus & pStatus) != combatStatus::None;
+}
+
+const char *statusName(combatStatus pStatus) {
+    switch (pStatus) {
+        case combatStatus::Attacking:
+            return "Attacking";
+        case combatStatus::Defending:
+            return "Defending";
+        case combatStatus::Prone:
+            return "Prone";
+        default:
+            return "";
+    }
+}
 
 void entity::setBaseHealth(float pHealth) {
     this->fBaseHealth = pHealth;
 }
-float entity::getBaseHealth() {
+float entity::getBaseHealth() const {
     return fBaseHealth;
 }
 
+
+/*
+ * Same row format read by player::makePlayer(): name, description, health, experience and
+ * alignment separated by commas. Some descriptions contain commas themselves, so the three numbers
+ * are taken from the end of the line and everything between the name and them is the description.
+ */
+vector<entityInfo> loadEntityInfo(const string &pPath) {
+    vector<entityInfo> rows;
+    ifstream fileIn(pPath);
+    string line;
+    while (getline(fileIn, line)) {
+        size_t nameEnd = line.find(',');
+        size_t alignmentStart = line.rfind(',');
+        size_t experienceStart = alignmentStart == string::npos ? string::npos
+                                                                : line.rfind(',', alignmentStart - 1);
+        size_t healthStart = experienceStart == string::npos ? string::npos
+                                                             : line.rfind(',', experienceStart - 1);
+        // Needs at least four commas (e.g. skips a "saved data:" header)
+        if (healthStart == string::npos || healthStart <= nameEnd)
+            continue;
+
+        entityInfo info;
+        info.name = line.substr(0, nameEnd);
+        info.description = line.substr(nameEnd + 1, healthStart - nameEnd - 1);
+        istringstream numbersIn(line.substr(healthStart + 1));
+        char comma;
+        numbersIn >> info.health >> comma >> info.experience >> comma >> info.alignment;
+        if (numbersIn.fail())
+            continue;
+        rows.push_back(info);
+    }
+    return rows;
+}
@@ -5,10 +5,49 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <cstdint>
 #include <string>
 #include <iostream>
+#include <vector>
 using namespace std;
 
+/*
+ * What an entity did last in battle. Stored as bit flags so combat checks are a single AND
+ * instead of a string compare; setStatus() replaces the whole set, hasStatus() tests one flag.
+ */
+enum class combatStatus : uint8_t {
+    None = 0,
+    Attacking = 1 << 0,
+    Defending = 1 << 1,
+    Prone = 1 << 2
+};
+
+inline combatStatus operator|(combatStatus a, combatStatus b) {
+    return static_cast<combatStatus>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+
+inline combatStatus operator&(combatStatus a, combatStatus b) {
+    return static_cast<combatStatus>(static_cast<uint8_t>(a) & static_cast<uint8_t>(b));
+}
+
+//Display name of a single status ("Attacking", "Defending", "Prone", or "" for None)
+const char *statusName(combatStatus pStatus);
+
+/*
+ * One row of an entity-data csv file: name, description, health, experience, alignment
+ */
+struct entityInfo {
+    string name;
+    string description;
+    float health = 0;
+    float experience = 0;
+    int alignment = 0;
+};
+
+//Reads every row of an entity-data csv. Lines that don't parse (e.g. a "saved data:" header)
+//are skipped. Returns an empty vector if the file can't be opened.
+vector<entityInfo> loadEntityInfo(const string &pPath);
+
 class entity {
     /*
      * An entity is an object that represents a living thing or 'creature'
@@ -28,37 +67,35 @@ public:
 
     //Method declaration for later implementation in game.cpp
     //Using descriptive method names and method parameters.
-    float getHealth();
+    float getHealth() const;
     void setHealth(float pHealth);
 
-    float getBaseHealth();
+    float getBaseHealth() const;
     void setBaseHealth(float pHealth);
 
-    int getExperience();
+    int getExperience() const;
     void setExperience(int pExperience);
     void addExperience(int pExperience);
 
-    string getName();
+    //Name and description are returned by reference, copy only if you need to keep them
+    const string &getName() const;
     void setName(string pName);
-    string getDescription();
+    const string &getDescription() const;
     void setDescription(string pDescription);
 
-    int getAlignment();
+    int getAlignment() const;
     void setAlignment(int pAlignment);
 
     void lowerHealth(int pAttackPower);
-    //Virtual method to later be overriden
-    virtual void generateEntity();
+    //Generates the null entity ("nil"), see the constructor below for a specific one
+    void generateEntity();
     //Base generate entity for specificity
     void generateEntity(float pHealth, float pExperience, string pName, string pDescription, int pAlignment);
 
 
-    string getStatus();
-    void setStatus(string pStatus);
-
-    //Later methods to be implemented by child classes
-    string defendAgainst(entity &pTarget);
-    string attackAgainst(entity &pTarget, int pLowerBy);
+    combatStatus getStatus() const;
+    void setStatus(combatStatus pStatus);
+    bool hasStatus(combatStatus pStatus) const;
 
     //friend for overloaded operator
     friend ostream& operator << (ostream& out, entity& entity) {
@@ -94,7 +131,7 @@ protected:
     string fDescription;
     //alignment is represented by -1 (evil) 0 (neutral) 1 (good)
     int fAlignment;
-    string fStatus;
+    combatStatus fStatus = combatStatus::None;
 
 
 };
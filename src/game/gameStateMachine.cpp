@@ -0,0 +1,187 @@
+//
+// Game flow (menus and battles) as a table-driven state machine.
+//
+
+#include "gameStateMachine.h"
+#include "combatRandom.h"
+
+/*
+ * All text is set on transitions only: while the player sits in a state nothing runs per frame.
+ * Messages are kept in session.message so headless runs can inspect them without a view, except
+ * battle turns: those are recorded as events in session.log and only formatted when a view is
+ * attached. The message is rebuilt in place (assign and append) so it stops allocating once it
+ * has grown to the longest turn.
+ */
+namespace {
+    // Default scroll speed of the message box, and the slow one used for dramatic effect
+    const float normalScroll = 15.0f;
+    const float slowScroll = 5.0f;
+
+    Health &health(GameSession &session, CombatantId id) {
+        return session.combatants->health.get(id);
+    }
+    const Health &health(const GameSession &session, CombatantId id) {
+        return session.combatants->health.get(id);
+    }
+
+    void show(GameSession &session, float scrollSpeed = normalScroll) {
+        if (session.view)
+            session.view->showMessage(session.message, scrollSpeed);
+    }
+
+    // Shows the combat events logged since firstEvent. Headless runs have no view and never
+    // format them.
+    void showTurn(GameSession &session, uint64_t firstEvent) {
+        if (!session.view)
+            return;
+        session.message.clear();
+        session.log.format(firstEvent, *session.combatants, session.message);
+        show(session);
+    }
+
+    // ---- Enter actions ----
+
+    void enterStart(GameSession &session) {
+        session.message = "Welcome to the game! Press enter to continue, or press (i) for game info";
+        show(session);
+    }
+
+    void enterEncounter(GameSession &session) {
+        session.message = "You have encountered a ";
+        session.message += session.combatants->getName(session.opponent);
+        session.message += '\n';
+        session.message += session.combatants->getDescription(session.opponent);
+        session.message += "\nWhat do you do?";
+        show(session);
+    }
+
+    void enterPlayerTurn(GameSession &session) {
+        session.message = "(A)ttack.\n(D)efend.\n(V)iew.\n(R)un.";
+        show(session);
+    }
+
+    void enterOver(GameSession &session) {
+        session.message = "You have died...";
+        show(session, slowScroll);
+    }
+
+    // ---- Transition actions ----
+
+    void showInfo(GameSession &session) {
+        session.message = "Here's the deal. You're a knight wandering the dark plain. You're "
+                          "going to encounter various *enemies* and they will try to attack "
+                          "you. Beware, you can Attack, Defend, View and Run. If you are to "
+                          "perish, you shall be reborn anew. So don't fret! Urist be with "
+                          "you.";
+        show(session);
+    }
+
+    void beginPlay(GameSession &session) {
+        if (session.view)
+            session.view->hideMessage();
+    }
+
+    void showSecretMenu(GameSession &session) {
+        session.message = "You just opened a secret menu!";
+        show(session);
+    }
+
+    // Player attacks for 0-49 damage, then the enemy makes its move
+    void playerAttack(GameSession &session) {
+        ++session.turns;
+        const uint64_t firstEvent = session.log.count();
+        CombatRegistry &combatants = *session.combatants;
+        attackAgainst(combatants, session.player, session.opponent, combatRandom(50), session.log);
+        enemyMoveAgainst(combatants, session.opponent, session.player, session.log);
+        showTurn(session, firstEvent);
+    }
+
+    void playerDefend(GameSession &session) {
+        ++session.turns;
+        const uint64_t firstEvent = session.log.count();
+        CombatRegistry &combatants = *session.combatants;
+        defendAgainst(combatants, session.player, session.opponent, session.log);
+        enemyMoveAgainst(combatants, session.opponent, session.player, session.log);
+        showTurn(session, firstEvent);
+    }
+
+    void viewStats(GameSession &session) {
+        ++session.turns;
+        session.message = "Your Health: ";
+        session.message += to_string(health(session, session.player).current);
+        session.message += "\nEnemy Health: ";
+        session.message += to_string(health(session, session.opponent).current);
+        show(session);
+    }
+
+    void runAway(GameSession &session) {
+        ++session.turns;
+        session.message = "You ran away!";
+        show(session);
+    }
+
+    // Announces a win before returning to platforming. Other outcomes are announced by the
+    // state that is entered next.
+    void concludeTurn(GameSession &session) {
+        if (health(session, session.opponent).current <= 0 &&
+            health(session, session.player).current > 0) {
+            session.message = "You defeated ";
+            session.message += session.combatants->getName(session.opponent);
+            show(session);
+        }
+    }
+
+    // "If you are to perish, you shall be reborn anew"
+    void restart(GameSession &session) {
+        Health &player = health(session, session.player);
+        player.current = player.base;
+        if (session.view)
+            session.view->resetLevel();
+    }
+
+    // ---- Selectors ----
+
+    GameState afterTurn(const GameSession &session) {
+        if (health(session, session.player).current <= 0)
+            return GameState::Over;
+        if (health(session, session.opponent).current <= 0)
+            return GameState::Play;
+        return GameState::PlayerTurn;
+    }
+
+    GameStateMachine::Table buildTable() {
+        GameStateMachine::Table table;
+        table.state(GameState::Start, "Start", enterStart)
+             .state(GameState::Play, "Play")
+             .state(GameState::Encounter, "Encounter", enterEncounter)
+             .state(GameState::PlayerTurn, "PlayerTurn", enterPlayerTurn)
+             .state(GameState::TurnResult, "TurnResult")
+             .state(GameState::Over, "Over", enterOver);
+
+        table.on(GameState::Start, GameEvent::Confirm, GameState::Play, beginPlay)
+             .on(GameState::Start, GameEvent::ShowInfo, GameState::Start, showInfo);
+
+        table.on(GameState::Play, GameEvent::SecretMenu, GameState::Play, showSecretMenu)
+             .on(GameState::Play, GameEvent::GoalReached, GameState::Encounter);
+
+        table.on(GameState::Encounter, GameEvent::Confirm, GameState::PlayerTurn)
+             .on(GameState::Encounter, GameEvent::Die, GameState::Over);
+
+        table.on(GameState::PlayerTurn, GameEvent::Attack, GameState::TurnResult, playerAttack)
+             .on(GameState::PlayerTurn, GameEvent::Defend, GameState::TurnResult, playerDefend)
+             .on(GameState::PlayerTurn, GameEvent::View, GameState::TurnResult, viewStats)
+             .on(GameState::PlayerTurn, GameEvent::Run, GameState::Play, runAway)
+             .on(GameState::PlayerTurn, GameEvent::Die, GameState::Over);
+
+        table.on(GameState::TurnResult, GameEvent::Confirm, afterTurn, concludeTurn)
+             .on(GameState::TurnResult, GameEvent::Die, GameState::Over);
+
+        table.on(GameState::Over, GameEvent::Restart, GameState::Start, restart);
+        return table;
+    }
+}
+
+const GameStateMachine::Table &gameStateTable() {
+    static const GameStateMachine::Table table = buildTable();
+    return table;
+}
@@ -0,0 +1,77 @@
+//
+// Game flow (menus and battles) as a table-driven state machine.
+//
+
+#ifndef GAME_STATE_MACHINE_H
+#define GAME_STATE_MACHINE_H
+
+#include <string>
+
+#include "battleLog.h"
+#include "combatRegistry.h"
+#include "../util/stateMachine.h"
+
+/// @brief Screens and battle phases.
+enum class GameState {
+    Start,      // Welcome/info text
+    Play,       // Platforming
+    Encounter,  // "You have encountered ..." shown, waiting for enter
+    PlayerTurn, // Battle options shown, waiting for A/D/V/R
+    TurnResult, // Outcome of the player's choice shown, waiting for enter
+    Over,       // Player died, waiting for restart
+    Count
+};
+
+/// @brief Inputs and game happenings that can change the state.
+enum class GameEvent {
+    Confirm,     // Enter
+    ShowInfo,    // I on the start screen
+    SecretMenu,  // M while platforming
+    Attack,      // A in battle
+    Defend,      // D in battle
+    View,        // V in battle
+    Run,         // R in battle
+    Die,         // B in battle (debug shortcut to the game over screen)
+    Restart,     // R on the game over screen
+    GoalReached, // Player touched the goal, opponent is set
+    Count
+};
+
+/// @brief What the state machine's actions need from the presentation layer.
+/// @details Implemented by Engine. Headless runs leave GameSession::view null.
+class GameView {
+public:
+    virtual ~GameView() = default;
+    /// @brief Shows text in the message box (opening it if closed).
+    virtual void showMessage(const string &text, float scrollSpeed) = 0;
+    /// @brief Closes the message box.
+    virtual void hideMessage() = 0;
+    /// @brief Rebuilds the level after a game over.
+    virtual void resetLevel() = 0;
+};
+
+/// @brief Everything the game state machine's actions operate on.
+struct GameSession {
+    /// @brief Where the player and opponent live.
+    CombatRegistry *combatants = nullptr;
+    CombatantId player = noCombatant;
+    /// @brief Enemy of the current battle, set before GoalReached is dispatched.
+    CombatantId opponent = noCombatant;
+    /// @brief Presentation, or null for headless simulation.
+    GameView *view = nullptr;
+    /// @brief The most recent message shown by an action.
+    /// @details Reused across turns, take a copy to keep one. Headless runs don't format battle
+    /// turns, read log instead.
+    string message;
+    /// @brief Combat events of recent turns. Turned into message text only when there's a view.
+    BattleLog log;
+    /// @brief Player actions taken in battle so far.
+    unsigned long turns = 0;
+};
+
+using GameStateMachine = StateMachine<GameState, GameEvent, GameSession>;
+
+/// @brief The game's states and transitions (built on first use).
+const GameStateMachine::Table &gameStateTable();
+
+#endif //GAME_STATE_MACHINE_H
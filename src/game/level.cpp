@@ -0,0 +1,86 @@
+#include "level.h"
+#include "../util/seedMix.h"
+
+#include <random>
+
+void layoutChunk(ChunkLayout &chunk, unsigned int width, size_t index, float chunkHeight,
+                 float platformHeight, unsigned int seed) {
+    std::minstd_rand random(mixSeed(seed, index));
+    chunk.platforms.clear();
+    const float bottom = index * chunkHeight;
+    const float top = bottom + chunkHeight;
+    float y;
+    if (index == 0) {
+        // The ground, as wide as the screen
+        chunk.platforms.push_back({vec2(width / 2, 50), vec2(width, platformHeight * 10)});
+        y = 200;
+    }
+    else {
+        // Less than a full step, so the gap from the chunk below's last platform stays jumpable
+        y = bottom + random() % 30;
+    }
+    for (; y < top; y += random() % 50 + 30) {
+        float x = random() % (width - 100) + 50;
+        float platformWidth = random() % 100 + 80;
+        chunk.platforms.push_back({vec2(x, y), vec2(platformWidth, platformHeight)});
+    }
+
+    // The goal sits 20 pixels above the highest platform
+    chunk.goal = chunk.platforms.back().pos + vec2(0, 20);
+}
+
+bool resolvePlatformCollisions(const vector<Rect *> &platforms, vec2 currentPos,
+                               const Rect &nextPosRect, vec2 &nextPos, vec2 &velocity) {
+    bool landed = false;
+    const vec2 size = nextPosRect.getSize();
+    for (const Rect *platform : platforms) {
+        if (!Rect::isOverlapping(nextPosRect, *platform))
+            continue;
+
+        // Landing on top of a platform
+        if (currentPos.y > platform->getPos().y && velocity.y < 0) {
+            nextPos.y = platform->getTop() + size.y / 2;
+            velocity.y = 0;
+            landed = true;
+        }
+        // If player is below a platform when jumping
+        else if (currentPos.y < platform->getPos().y && velocity.y > 0) {
+            nextPos.y = platform->getBottom() - size.y / 2;
+            velocity.y = 0;
+        }
+        // If player is to the left of a platform when moving horizontally
+        else if (currentPos.x < platform->getPos().x) {
+            nextPos.x = platform->getLeft() - size.x / 2;
+            velocity.x = 0;
+        }
+        // If player is to the right of a platform when moving horizontally
+        else if (currentPos.x > platform->getPos().x) {
+            nextPos.x = platform->getRight() + size.x / 2;
+            velocity.x = 0;
+        }
+    }
+    return landed;
+}
+
+void queryPlatformOverlaps(JobSystem &jobs, const vector<unique_ptr<Rect>> &platforms,
+                           const vector<CollisionBox> &queries, vector<int> &firstHit,
+                           size_t grainSize) {
+    firstHit.assign(queries.size(), -1);
+    JobFence fence;
+    jobs.parallelFor(fence, queries.size(), grainSize, [&](size_t begin, size_t end) {
+        for (size_t q = begin; q < end; ++q) {
+            const vec2 half = queries[q].size / 2.0f;
+            const vec2 low = queries[q].pos - half;
+            const vec2 high = queries[q].pos + half;
+            for (size_t p = 0; p < platforms.size(); ++p) {
+                const Rect &platform = *platforms[p];
+                if (!(high.x < platform.getLeft() || low.x > platform.getRight() ||
+                      low.y > platform.getTop() || high.y < platform.getBottom())) {
+                    firstHit[q] = static_cast<int>(p);
+                    break;
+                }
+            }
+        }
+    });
+    jobs.wait(fence);
+}
@@ -0,0 +1,66 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <memory>
+#include <vector>
+
+#include "../shapes/rect.h"
+#include "../util/jobSystem.h"
+
+using std::vector, std::unique_ptr;
+
+/*
+ * Level layout and platform physics used by LevelStream (which lays chunks out on the job
+ * system), Engine::updatePlatforming and the benchmarks in bench/. Kept as free functions so they
+ * can be exercised without a whole Engine (and its window). Layouts and queries are plain data,
+ * so none of this touches GL.
+ */
+
+/// @brief Where a platform goes, without its GL objects.
+struct PlatformLayout {
+    vec2 pos;
+    vec2 size;
+};
+
+/// @brief One fixed-height slice of a streamed level (see LevelStream).
+struct ChunkLayout {
+    vector<PlatformLayout> platforms;
+    /// @brief Where the chunk's goal goes: just above its highest platform
+    vec2 goal;
+};
+
+/// @brief Lays out chunk index of an endless level, from index * chunkHeight up to the next
+/// chunk, into chunk (reusing its storage).
+/// @details Chunk 0 starts with the ground and has its first platform at y=200; every platform
+/// is 30-80 pixels above the one before, at a random x and width within the screen. Every chunk has its own
+/// generator seeded from seed and index, so a chunk can be laid out alone on any thread and always
+/// comes out the same.
+void layoutChunk(ChunkLayout &chunk, unsigned int width, size_t index, float chunkHeight,
+                 float platformHeight, unsigned int seed);
+
+/// @brief Resolves the player's next position against every platform.
+/// @param platforms Platforms to collide with (e.g. LevelStream::getPlatforms())
+/// @param currentPos The player's position this frame
+/// @param nextPosRect A rect at the player's tentative next position
+/// @param nextPos Tentative next position, pushed out of any platform it overlaps
+/// @param velocity Player velocity, zeroed along the axis of any collision
+/// @return true if the player landed on top of a platform
+bool resolvePlatformCollisions(const vector<Rect *> &platforms, vec2 currentPos,
+                               const Rect &nextPosRect, vec2 &nextPos, vec2 &velocity);
+
+/// @brief Axis-aligned box for collision queries that don't need a drawable Rect.
+struct CollisionBox {
+    vec2 pos;
+    vec2 size;
+};
+
+/// @brief For every query box, the index of the first platform it overlaps (-1 for none).
+/// @details Same overlap test as Rect::isOverlapping. Queries are split across jobs of
+/// grainSize boxes and this waits for them, so it can be called from any thread.
+/// The engine only ever tests the one player box (resolvePlatformCollisions); this batch form is
+/// for bench/benchJobs.cpp.
+void queryPlatformOverlaps(JobSystem &jobs, const vector<unique_ptr<Rect>> &platforms,
+                           const vector<CollisionBox> &queries, vector<int> &firstHit,
+                           size_t grainSize = 256);
+
+#endif //LEVEL_H
@@ -0,0 +1,139 @@
+#include "levelStream.h"
+
+#include <algorithm>
+
+LevelStream::LevelStream(JobSystem &jobs, Shader &shader, color fill, unsigned int width,
+                         float chunkHeight, float platformHeight)
+    : jobs(jobs), shader(shader), fill(fill), width(width), chunkHeight(chunkHeight),
+      platformHeight(platformHeight) {}
+
+LevelStream::~LevelStream() {
+    jobs.wait(layouts);
+}
+
+void LevelStream::reset(unsigned int newSeed) {
+    // Layouts still running finish into chunks nobody builds
+    for (PendingHandle handle : pending)
+        retire(handle);
+    pending.clear();
+    chunks.clear();
+    for (ObjectPool<Rect>::Handle handle : platformHandles)
+        platformPool.release(handle);
+    platforms.clear();
+    platformHandles.clear();
+    seed = newSeed;
+    lowestChunk = nextRequest = 0;
+}
+
+size_t LevelStream::chunkAt(float y) const {
+    return y <= 0.0f ? 0 : static_cast<size_t>(y / chunkHeight);
+}
+
+float LevelStream::getBottom() const {
+    return (chunks.empty() ? lowestChunk : chunks.front().index) * chunkHeight;
+}
+
+float LevelStream::getTop() const {
+    return chunks.empty() ? getBottom() : (chunks.back().index + 1) * chunkHeight;
+}
+
+bool LevelStream::findGoal(size_t index, vec2 &goal) const {
+    for (const BuiltChunk &chunk : chunks) {
+        if (chunk.index == index) {
+            goal = chunk.goal;
+            return true;
+        }
+    }
+    return false;
+}
+
+void LevelStream::retire(PendingHandle handle) {
+    retired.push_back(handle);
+}
+
+void LevelStream::releaseRetired() {
+    for (size_t i = 0; i < retired.size();) {
+        if (pendingPool.get(retired[i])->ready.load(std::memory_order_acquire)) {
+            pendingPool.release(retired[i]);
+            retired[i] = retired.back();
+            retired.pop_back();
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+void LevelStream::dropBelow(size_t index) {
+    if (index <= lowestChunk)
+        return;
+    lowestChunk = index;
+    size_t droppedChunks = 0, dropped = 0;
+    while (droppedChunks < chunks.size() && chunks[droppedChunks].index < index)
+        dropped += chunks[droppedChunks++].platformCount;
+    chunks.erase(chunks.begin(), chunks.begin() + droppedChunks);
+    for (size_t i = 0; i < dropped; ++i)
+        platformPool.release(platformHandles[i]);
+    platforms.erase(platforms.begin(), platforms.begin() + dropped);
+    platformHandles.erase(platformHandles.begin(), platformHandles.begin() + dropped);
+    size_t retiredCount = 0;
+    while (retiredCount < pending.size() && pendingPool.get(pending[retiredCount])->index < index)
+        retire(pending[retiredCount++]);
+    pending.erase(pending.begin(), pending.begin() + retiredCount);
+    nextRequest = std::max(nextRequest, index);
+}
+
+void LevelStream::buildNext() {
+    const PendingChunk &chunk = *pendingPool.get(pending.front());
+    // Recycled platforms keep their GL objects; only where they go changes
+    for (const PlatformLayout &layout : chunk.layout.platforms) {
+        ObjectPool<Rect>::Handle handle = platformPool.acquire(
+            [&layout](Rect &platform) {
+                platform.setPos(layout.pos);
+                platform.setSize(layout.size);
+            },
+            shader, layout.pos, layout.size, fill);
+        platforms.push_back(platformPool.get(handle));
+        platformHandles.push_back(handle);
+    }
+    chunks.push_back({chunk.index, chunk.layout.platforms.size(), chunk.layout.goal});
+    pendingPool.release(pending.front());
+    pending.erase(pending.begin());
+}
+
+void LevelStream::update(float viewBottom, float viewTop) {
+    releaseRetired();
+    const size_t bottomChunk = chunkAt(viewBottom);
+    dropBelow(bottomChunk > chunksBehind ? bottomChunk - chunksBehind : 0);
+
+    // One chunk a frame: building may create GL objects for every platform
+    if (!pending.empty() && pendingPool.get(pending.front())->ready.load(std::memory_order_acquire))
+        buildNext();
+
+    const size_t lastWanted = chunkAt(viewTop) + chunksAhead;
+    for (; nextRequest <= lastWanted; ++nextRequest) {
+        PendingHandle handle = pendingPool.acquire([this](PendingChunk &chunk) {
+            chunk.index = nextRequest;
+            chunk.width = width;
+            chunk.chunkHeight = chunkHeight;
+            chunk.platformHeight = platformHeight;
+            chunk.seed = seed;
+            chunk.ready.store(false, std::memory_order_relaxed);
+        });
+        PendingChunk *chunk = pendingPool.get(handle);
+        pending.push_back(handle);
+        // Only a pointer is captured, so the job fits in std::function without allocating
+        jobs.run(layouts, [chunk] {
+            layoutChunk(chunk->layout, chunk->width, chunk->index, chunk->chunkHeight,
+                        chunk->platformHeight, chunk->seed);
+            chunk->ready.store(true, std::memory_order_release);
+        });
+    }
+}
+
+void LevelStream::finish() {
+    jobs.wait(layouts);
+    releaseRetired();
+    while (!pending.empty())
+        buildNext();
+}
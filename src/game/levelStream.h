@@ -0,0 +1,132 @@
+#ifndef LEVEL_STREAM_H
+#define LEVEL_STREAM_H
+
+#include <atomic>
+#include <vector>
+
+#include "level.h"
+#include "../util/objectPool.h"
+
+using std::vector;
+
+/**
+ * @brief An endless vertical level, split into fixed-height chunks that are laid out on the job
+ * system ahead of the view and dropped once they fall behind it.
+ * @details Only the chunks from chunksBehind below the view to chunksAhead above it exist, so the
+ * number of platforms (and their GL objects) stays the same however far the player climbs.
+ * Layouts (layoutChunk(), pure data) run on workers; update() turns at most one finished layout a
+ * frame into Rects, since that needs the GL thread, and never waits for a worker. Chunks are kept
+ * in height order and their platforms are stored one after the other in getPlatforms(), so
+ * collision and culling see a single vector.
+ *
+ * Platforms and pending layouts come from ObjectPools and are recycled, so once the pools have
+ * grown to the most the level ever holds, streaming creates no GL objects and (apart from the job
+ * system's queues) makes no heap allocations.
+ */
+class LevelStream {
+public:
+    /// @brief Chunks kept above the one at the top of the view
+    static constexpr size_t chunksAhead = 2;
+    /// @brief Chunks kept below the one at the bottom of the view
+    static constexpr size_t chunksBehind = 1;
+
+    /// @param shader Shader the platforms are drawn with
+    /// @param fill Color of the platforms
+    /// @param width Width of the level (the screen width)
+    /// @param chunkHeight Height of every chunk
+    /// @param platformHeight Thickness of the platforms
+    LevelStream(JobSystem &jobs, Shader &shader, color fill, unsigned int width, float chunkHeight,
+                float platformHeight);
+    /// @brief Waits for layouts still running.
+    ~LevelStream();
+
+    LevelStream(const LevelStream &) = delete;
+    LevelStream &operator=(const LevelStream &) = delete;
+
+    /// @brief Drops every chunk and starts a new level; the same seed gives the same level.
+    void reset(unsigned int seed);
+
+    /// @brief Streams the level around the view (GL thread, once per frame).
+    /// @details Drops chunks too far below the view, builds the next finished layout and requests
+    /// layouts up to chunksAhead above the view.
+    void update(float viewBottom, float viewTop);
+
+    /// @brief Waits for every requested layout and builds it (level start, offscreen runs).
+    void finish();
+
+    /// @brief Platforms of every built chunk, lowest chunk first (owned by the stream).
+    const vector<Rect *> &getPlatforms() const { return platforms; }
+
+    /// @brief Bottom of the lowest built chunk.
+    float getBottom() const;
+    /// @brief Top of the highest built chunk (getBottom() if none is built).
+    float getTop() const;
+
+    /// @brief Index of the chunk containing height y.
+    size_t chunkAt(float y) const;
+
+    /// @brief Where a chunk's goal goes.
+    /// @return false if the chunk isn't built (not yet, or not any more)
+    bool findGoal(size_t index, vec2 &goal) const;
+
+    /// @brief Number of chunks built and not yet dropped.
+    size_t getChunkCount() const { return chunks.size(); }
+
+private:
+    /// @brief A requested layout. The job reads its inputs and writes layout, then sets ready;
+    /// the GL thread only reads layout once ready is set.
+    struct PendingChunk {
+        size_t index = 0;
+        unsigned int width = 0;
+        float chunkHeight = 0, platformHeight = 0;
+        unsigned int seed = 0;
+        std::atomic<bool> ready{false};
+        ChunkLayout layout;
+    };
+    using PendingHandle = ObjectPool<PendingChunk>::Handle;
+
+    /// @brief A chunk whose platforms are in the platforms vector.
+    struct BuiltChunk {
+        size_t index;
+        size_t platformCount;
+        vec2 goal;
+    };
+
+    JobSystem &jobs;
+    JobFence layouts;
+    Shader &shader;
+    color fill;
+    unsigned int width;
+    float chunkHeight;
+    float platformHeight;
+    unsigned int seed = 1;
+
+    ObjectPool<PendingChunk> pendingPool;
+    /// @brief Requested chunks not built yet, lowest first. A handful at most, so vectors popped
+    /// from the front (which keep their capacity, unlike a deque's blocks) are used for both.
+    vector<PendingHandle> pending;
+    /// @brief Pending chunks that were dropped while their job may still be running; released
+    /// back to the pool once it has finished.
+    vector<PendingHandle> retired;
+    /// @brief Built chunks, lowest first.
+    vector<BuiltChunk> chunks;
+
+    ObjectPool<Rect> platformPool;
+    /// @brief Built platforms and their handles, in the same order.
+    vector<Rect *> platforms;
+    vector<ObjectPool<Rect>::Handle> platformHandles;
+
+    /// @brief The lowest chunk still wanted and the next one to request.
+    size_t lowestChunk = 0, nextRequest = 0;
+
+    /// @brief Drops built chunks (and pending ones) below index.
+    void dropBelow(size_t index);
+    /// @brief Creates the platforms of the lowest pending chunk.
+    void buildNext();
+    /// @brief Moves a pending chunk to retired.
+    void retire(PendingHandle handle);
+    /// @brief Releases retired chunks whose jobs have finished.
+    void releaseRetired();
+};
+
+#endif //LEVEL_STREAM_H
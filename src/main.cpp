@@ -1,18 +1,138 @@
 
 #include "engine.h"
+#include "util/profiler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 
+/// @brief Prints the results of a --benchmark run.
+void reportBenchmark(vector<double> &frameTimes, double totalSeconds) {
+    std::sort(frameTimes.begin(), frameTimes.end());
+    auto percentile = [&](double p) {
+        return frameTimes[static_cast<size_t>(p * (frameTimes.size() - 1))] * 1000.0;
+    };
+    std::cout << "Benchmark: " << frameTimes.size() << " frames in " << totalSeconds << " s\n"
+              << "  Average FPS: " << frameTimes.size() / totalSeconds << "\n"
+              << "  Frame time p50: " << percentile(0.50) << " ms, p95: " << percentile(0.95)
+              << " ms, p99: " << percentile(0.99) << " ms, max: " << frameTimes.back() * 1000.0
+              << " ms" << std::endl;
+}
+
 int main(int argc, char *argv[]) {
-    Engine engine;
+    /*
+     * Command line options:
+     *   --trace <file>                  record every frame and write a Chrome trace on exit
+     *   --offscreen                     render into an offscreen framebuffer (no window or display needed)
+     *   --frames <n>                    stop after n frames
+     *   --dump-frames <dir>             offscreen: write every frame to <dir>/frame_NNNNN.png
+     *   --vsync <on|off|adaptive>       present mode (default on)
+     *   --fps <n>                       cap the frame rate at n frames per second
+     *   --benchmark <n>                 run n frames with vsync off and no cap, then report FPS
+     *   --shader-cache <dir|off>        where compiled shader programs are cached (default shader-cache)
+     *   --no-hot-reload                 don't recompile shaders when their files change
+     *   --check-allocations <n>         fail if any frame after the first n allocates on the heap
+     *   --autoplay                      play by itself: menus, battles and climbing (for offscreen runs)
+     */
+    const char *tracePath = nullptr;
+    unsigned int benchmarkFrames = 0;
+    EngineConfig config;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+            tracePath = argv[++i];
+        else if (!strcmp(argv[i], "--offscreen"))
+            config.offscreen = true;
+        else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+            config.frameLimit = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--dump-frames") && i + 1 < argc)
+            config.frameDumpDir = argv[++i];
+        else if (!strcmp(argv[i], "--vsync") && i + 1 < argc) {
+            const char *mode = argv[++i];
+            if (!strcmp(mode, "off"))
+                config.presentMode = PresentMode::Immediate;
+            else if (!strcmp(mode, "adaptive"))
+                config.presentMode = PresentMode::Adaptive;
+            else
+                config.presentMode = PresentMode::VSync;
+        }
+        else if (!strcmp(argv[i], "--fps") && i + 1 < argc)
+            config.targetFps = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--benchmark") && i + 1 < argc)
+            benchmarkFrames = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--no-hot-reload"))
+            config.hotReloadShaders = false;
+        else if (!strcmp(argv[i], "--shader-cache") && i + 1 < argc) {
+            const char *dir = argv[++i];
+            config.shaderCacheDir = strcmp(dir, "off") ? dir : "";
+        }
+        else if (!strcmp(argv[i], "--check-allocations") && i + 1 < argc)
+            config.allocationCheckAfter = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--autoplay"))
+            config.autoplay = true;
+        else
+            std::cout << "Unknown option: " << argv[i] << std::endl;
+    }
+#ifndef RUNNER_COUNT_ALLOCATIONS
+    if (config.allocationCheckAfter) {
+        // Without the operator new hook every frame would pass
+        std::cerr << "--check-allocations needs a build with RUNNER_COUNT_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+#endif
+    if (benchmarkFrames) {
+        // Measure headroom, not the monitor's refresh rate
+        config.presentMode = PresentMode::Immediate;
+        config.targetFps = 0.0;
+        config.frameLimit = benchmarkFrames;
+    }
+    if (tracePath) {
+        Profiler::setThreadName("Main");
+        Profiler::setEnabled(true);
+    }
+
+    // The engine's GL objects are released in its destructor, which needs the context, so it
+    // goes out of scope before glfwTerminate()
+    unsigned long allocatingFrames = 0;
+    {
+        Engine engine(config);
 
-    while (!engine.shouldClose()) {
-        engine.processInput();
-        engine.update();
-        engine.render();
+        using clock = std::chrono::steady_clock;
+        vector<double> frameTimes;
+        frameTimes.reserve(benchmarkFrames);
+        const clock::time_point runStart = clock::now();
+        clock::time_point frameStart = runStart;
+
+        while (!engine.shouldClose()) {
+            PROFILE_ZONE("frame");
+            engine.processInput();
+            engine.update();
+            engine.render();
+
+            if (benchmarkFrames) {
+                clock::time_point frameEnd = clock::now();
+                frameTimes.push_back(std::chrono::duration<double>(frameEnd - frameStart).count());
+                frameStart = frameEnd;
+            }
+        }
+
+        if (benchmarkFrames && !frameTimes.empty())
+            reportBenchmark(frameTimes,
+                            std::chrono::duration<double>(clock::now() - runStart).count());
+
+        if (tracePath && Profiler::writeChromeTrace(tracePath))
+            std::cout << "Wrote trace to " << tracePath << std::endl;
+
+        allocatingFrames = engine.getAllocatingFrames();
     }
 
     glfwTerminate();
+    if (allocatingFrames) {
+        std::cerr << "Allocation check failed: " << allocatingFrames
+                  << " frames allocated on the heap" << std::endl;
+        return 1;
+    }
     return 0;
-}
\ No newline at end of file
+}
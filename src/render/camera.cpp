@@ -0,0 +1,50 @@
+#include "camera.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <limits>
+
+Camera::Camera(float screenWidth, float screenHeight)
+    : screenSize(screenWidth, screenHeight), position(screenWidth / 2.0f, screenHeight / 2.0f),
+      limitBottom(std::numeric_limits<float>::lowest()), limitTop(std::numeric_limits<float>::max()) {}
+
+void Camera::setPosition(vec2 newPosition) {
+    position = newPosition;
+    clampToLimits();
+}
+
+void Camera::setZoom(float newZoom) {
+    zoom = newZoom > 0.0f ? newZoom : 1.0f;
+    clampToLimits();
+}
+
+void Camera::setVerticalLimits(float bottom, float top) {
+    limitBottom = bottom;
+    limitTop = top;
+    clampToLimits();
+}
+
+void Camera::follow(vec2 target, float deltaTime, float stiffness) {
+    // Exponential smoothing, so the camera eases the same way at any frame rate
+    const float blend = 1.0f - std::exp(-stiffness * deltaTime);
+    setPosition(position + (target - position) * blend);
+}
+
+void Camera::clampToLimits() {
+    const float halfHeight = screenSize.y / (2.0f * zoom);
+    if (limitTop - limitBottom <= 2.0f * halfHeight)
+        position.y = (limitBottom + limitTop) / 2.0f;
+    else
+        position.y = glm::clamp(position.y, limitBottom + halfHeight, limitTop - halfHeight);
+}
+
+glm::mat4 Camera::getViewProjection() const {
+    const CollisionAabb view = getView();
+    return glm::ortho(view.min.x, view.max.x, view.min.y, view.max.y, -1.0f, 1.0f);
+}
+
+CollisionAabb Camera::getView() const {
+    const vec2 half = screenSize / (2.0f * zoom);
+    return {position - half, position + half};
+}
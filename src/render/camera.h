@@ -0,0 +1,72 @@
+#ifndef RUNNER_CAMERA_H
+#define RUNNER_CAMERA_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include "../shapes/collision.h"
+
+/**
+ * @brief A 2D camera: the part of the world shown on screen.
+ * @details The view is a box of the screen's size divided by the zoom, centered on the camera's
+ * position and kept inside optional vertical limits (so the view never shows below the ground or
+ * above the top of the level). getViewProjection() replaces the fixed screen projection for
+ * anything drawn in world coordinates; cull() picks out what intersects the view so only that is
+ * submitted, keeping render cost proportional to what is visible rather than to the level.
+ */
+class Camera {
+public:
+    /// @param screenWidth,screenHeight Size of the screen in pixels (the view at zoom 1)
+    Camera(float screenWidth, float screenHeight);
+
+    /// @brief Centers the view on position (within the limits).
+    void setPosition(vec2 position);
+    /// @brief The center of the view.
+    vec2 getPosition() const { return position; }
+
+    /// @brief Magnification: 2 shows half as much of the world, twice as large.
+    void setZoom(float zoom);
+    float getZoom() const { return zoom; }
+
+    /// @brief Keeps the view between bottom and top (or centered on them if the view is taller).
+    void setVerticalLimits(float bottom, float top);
+
+    /// @brief Eases toward target, covering most of the way in about 1 / stiffness seconds.
+    void follow(vec2 target, float deltaTime, float stiffness = 8.0f);
+
+    /// @brief Orthographic projection of the view onto the screen.
+    glm::mat4 getViewProjection() const;
+
+    /// @brief The world area on screen.
+    CollisionAabb getView() const;
+
+    /// @brief Whether a box intersects the view.
+    bool isVisible(const CollisionAabb &box) const { return overlapBoxBox(box, getView()); }
+
+    /// @brief Collects the shapes that intersect the view.
+    /// @param shapes Pointers (raw or smart) to the shapes; null entries are skipped
+    /// @param visible Cleared, then filled in order (reuse it across frames to avoid allocating)
+    /// @return Number of shapes left out
+    template <typename ShapePointers, typename ShapeType>
+    size_t cull(const ShapePointers &shapes, std::vector<const ShapeType *> &visible) const {
+        const CollisionAabb view = getView();
+        visible.clear();
+        for (const auto &shape : shapes) {
+            if (shape && overlapBoxBox(aabbOf(*shape), view))
+                visible.push_back(&*shape);
+        }
+        return shapes.size() - visible.size();
+    }
+
+private:
+    vec2 screenSize;
+    vec2 position;
+    float zoom = 1.0f;
+    float limitBottom, limitTop;
+
+    /// @brief Moves position back inside the vertical limits.
+    void clampToLimits();
+};
+
+#endif //RUNNER_CAMERA_H
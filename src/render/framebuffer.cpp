@@ -0,0 +1,54 @@
+#include "framebuffer.h"
+#include "../util/png.h"
+
+#include <cstring>
+
+Framebuffer::Framebuffer(unsigned int width, unsigned int height) : width(width), height(height) {
+    glGenFramebuffers(1, &FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+}
+
+Framebuffer::~Framebuffer() {
+    glDeleteFramebuffers(1, &FBO);
+    glDeleteRenderbuffers(1, &colorBuffer);
+}
+
+void Framebuffer::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+}
+
+bool Framebuffer::isComplete() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void Framebuffer::readPixels(std::vector<unsigned char> &pixels) const {
+    const size_t rowSize = width * 4;
+    pixels.resize(rowSize * height);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    // OpenGL returns the bottom row first, images expect the top row first
+    std::vector<unsigned char> row(rowSize);
+    for (unsigned int y = 0; y < height / 2; ++y) {
+        unsigned char *top = pixels.data() + y * rowSize;
+        unsigned char *bottom = pixels.data() + (height - 1 - y) * rowSize;
+        memcpy(row.data(), top, rowSize);
+        memcpy(top, bottom, rowSize);
+        memcpy(bottom, row.data(), rowSize);
+    }
+}
+
+bool Framebuffer::savePng(const std::string &path) const {
+    std::vector<unsigned char> pixels;
+    readPixels(pixels);
+    return writePng(path, pixels.data(), width, height);
+}
@@ -0,0 +1,46 @@
+#ifndef RUNNER_FRAMEBUFFER_H
+#define RUNNER_FRAMEBUFFER_H
+
+#include <glad/glad.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief An offscreen render target with a single RGBA8 color attachment.
+ * @details Used in place of the window's default framebuffer when the engine runs offscreen.
+ */
+class Framebuffer {
+public:
+    /// @brief Creates the framebuffer object and its color renderbuffer.
+    Framebuffer(unsigned int width, unsigned int height);
+
+    /// @brief Deletes the framebuffer and renderbuffer.
+    ~Framebuffer();
+
+    Framebuffer(const Framebuffer &) = delete;
+    Framebuffer &operator=(const Framebuffer &) = delete;
+
+    /// @brief Directs all following draws into this framebuffer.
+    void bind() const;
+
+    /// @brief Returns true if the framebuffer is complete and can be rendered to.
+    bool isComplete() const;
+
+    /// @brief Reads back the color attachment.
+    /// @param pixels Resized to width * height * 4 and filled with RGBA rows, top row first.
+    void readPixels(std::vector<unsigned char> &pixels) const;
+
+    /// @brief Reads back the color attachment and writes it to a PNG file.
+    /// @return true if the file was written.
+    bool savePng(const std::string &path) const;
+
+    unsigned int getWidth() const { return width; }
+    unsigned int getHeight() const { return height; }
+
+private:
+    GLuint FBO = 0, colorBuffer = 0;
+    unsigned int width, height;
+};
+
+#endif //RUNNER_FRAMEBUFFER_H
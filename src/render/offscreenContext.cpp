@@ -0,0 +1,103 @@
+#include "offscreenContext.h"
+
+#include <iostream>
+
+#ifdef RUNNER_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+OffscreenContext::~OffscreenContext() {
+    destroy();
+}
+
+#ifdef RUNNER_HAS_EGL
+
+bool OffscreenContext::create() {
+    // Prefer the surfaceless platform, which works without X11/Wayland or a DRM device
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    if (getPlatformDisplay)
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (eglDisplay == EGL_NO_DISPLAY)
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, nullptr, nullptr)) {
+        std::cout << "ERROR::EGL: Could not initialize a display" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cout << "ERROR::EGL: Desktop OpenGL is not supported" << std::endl;
+        return false;
+    }
+
+    // Surfaceless configs only advertise pbuffer support (the default is EGL_WINDOW_BIT)
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        std::cout << "ERROR::EGL: No suitable framebuffer config" << std::endl;
+        return false;
+    }
+
+    // Same version and profile the GLFW window asks for
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cout << "ERROR::EGL: Could not create an OpenGL 3.3 core context" << std::endl;
+        return false;
+    }
+    context = eglContext;
+
+    // Needs EGL_KHR_surfaceless_context, which every Mesa driver exposes
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cout << "ERROR::EGL: Could not make the context current" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void OffscreenContext::destroy() {
+    if (!display)
+        return;
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context)
+        eglDestroyContext(display, context);
+    eglTerminate(display);
+    context = nullptr;
+    display = nullptr;
+}
+
+void *OffscreenContext::getProcAddress(const char *name) {
+    return reinterpret_cast<void *>(eglGetProcAddress(name));
+}
+
+#else
+
+bool OffscreenContext::create() {
+    std::cout << "ERROR::EGL: Built without EGL support" << std::endl;
+    return false;
+}
+
+void OffscreenContext::destroy() {}
+
+void *OffscreenContext::getProcAddress(const char *) {
+    return nullptr;
+}
+
+#endif
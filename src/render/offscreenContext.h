@@ -0,0 +1,34 @@
+#ifndef RUNNER_OFFSCREEN_CONTEXT_H
+#define RUNNER_OFFSCREEN_CONTEXT_H
+
+/**
+ * @brief A window-less OpenGL 3.3 core context.
+ * @details Created through EGL on the Mesa surfaceless platform, so it needs neither a display
+ * server nor a GPU (Mesa falls back to llvmpipe). There is no default framebuffer: render into a
+ * Framebuffer instead. Only available when built with RUNNER_HAS_EGL; otherwise create() fails and
+ * callers fall back to a hidden GLFW window.
+ */
+class OffscreenContext {
+public:
+    OffscreenContext() = default;
+    ~OffscreenContext();
+    OffscreenContext(const OffscreenContext &) = delete;
+    OffscreenContext &operator=(const OffscreenContext &) = delete;
+
+    /// @brief Creates the context and makes it current on the calling thread.
+    /// @return true if successful.
+    bool create();
+
+    /// @brief Releases and destroys the context.
+    void destroy();
+
+    /// @brief GL function loader for gladLoadGLLoader().
+    static void *getProcAddress(const char *name);
+
+private:
+    /// @brief EGLDisplay and EGLContext, kept opaque so EGL headers stay out of engine.h.
+    void *display = nullptr;
+    void *context = nullptr;
+};
+
+#endif //RUNNER_OFFSCREEN_CONTEXT_H
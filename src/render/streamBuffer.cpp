@@ -0,0 +1,126 @@
+#include "streamBuffer.h"
+
+namespace {
+    /// @brief Size of the shared ring: many frames of text and batched shapes.
+    const GLsizeiptr sharedCapacity = 4 << 20;
+
+    bool hasBufferStorage() {
+        return GLAD_GL_ARB_buffer_storage || GLVersion.major > 4 ||
+               (GLVersion.major == 4 && GLVersion.minor >= 4);
+    }
+}
+
+std::unique_ptr<StreamBuffer> StreamBuffer::sharedBuffer;
+
+StreamBuffer::StreamBuffer(GLsizeiptr capacity)
+    : capacity(capacity), segmentSize((capacity + segmentCount - 1) / segmentCount) {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (hasBufferStorage()) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, capacity, nullptr, flags);
+        mapped = static_cast<unsigned char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, capacity, flags));
+    }
+    if (!mapped)
+        glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+StreamBuffer::~StreamBuffer() {
+    for (const auto &fence : fences)
+        glDeleteSync(fence.second);
+    if (mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &buffer);
+}
+
+StreamBuffer &StreamBuffer::shared() {
+    if (!sharedBuffer)
+        sharedBuffer = std::make_unique<StreamBuffer>(sharedCapacity);
+    return *sharedBuffer;
+}
+
+void StreamBuffer::releaseShared() {
+    sharedBuffer.reset();
+}
+
+void *StreamBuffer::map(GLsizeiptr bytes, GLsizeiptr alignment) {
+    if (bytes > capacity)
+        return nullptr;
+    GLintptr start = (head + alignment - 1) / alignment * alignment;
+    if (start + bytes > capacity) {
+        start = 0;
+        if (mapped) {
+            // Fence what this frame has drawn so far, in case a single frame wraps all the way
+            // around into its own data
+            fenceFrame();
+        }
+        else {
+            // Orphan: new storage for us, the old one stays alive until its draws are done
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        }
+    }
+    offset = start;
+    head = start + bytes;
+
+    if (mapped) {
+        claimSegments(start / segmentSize, (start + bytes - 1) / segmentSize);
+        return mapped + start;
+    }
+    // Nothing has been drawn from this range since the last orphan, so no need to synchronize
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    return glMapBufferRange(GL_ARRAY_BUFFER, start, bytes,
+                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void StreamBuffer::unmap() {
+    // Persistent mappings are coherent, writes are visible to the next draw
+    if (mapped)
+        return;
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StreamBuffer::fenceFrame() {
+    if (!mapped)
+        return;
+    fences.emplace_back(frame++, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    // Drop fences the GPU has already passed so the list stays a few frames long
+    while (fences.size() > 1) {
+        GLenum status = glClientWaitSync(fences.front().second, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            break;
+        glDeleteSync(fences.front().second);
+        fences.pop_front();
+    }
+}
+
+void StreamBuffer::claimSegments(GLintptr first, GLintptr last) {
+    for (GLintptr segment = first; segment <= last; ++segment) {
+        if (segmentFrame[segment] != 0 && segmentFrame[segment] != frame)
+            waitForFrame(segmentFrame[segment]);
+        segmentFrame[segment] = frame;
+    }
+}
+
+void StreamBuffer::waitForFrame(unsigned long lastFrame) {
+    // Fences signal in order, so waiting for the newest one up to lastFrame covers the rest
+    GLsync newest = nullptr;
+    while (!fences.empty() && fences.front().first <= lastFrame) {
+        if (newest)
+            glDeleteSync(newest);
+        newest = fences.front().second;
+        fences.pop_front();
+    }
+    if (!newest)
+        return;
+    GLenum status;
+    do {
+        status = glClientWaitSync(newest, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    } while (status == GL_TIMEOUT_EXPIRED);
+    glDeleteSync(newest);
+}
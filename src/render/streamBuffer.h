@@ -0,0 +1,87 @@
+#ifndef RUNNER_STREAM_BUFFER_H
+#define RUNNER_STREAM_BUFFER_H
+
+#include <glad/glad.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Ring buffer for vertex data that is rewritten every frame (text quads, batched shapes).
+ * @details Callers map() a range, write their vertices and unmap() before drawing from
+ * getOffset(). Data is only appended, never overwritten while the GPU may still read it, so no
+ * write waits on a draw the way glBufferSubData on a buffer in use does.
+ *
+ * With ARB_buffer_storage (or GL 4.4) the buffer is mapped once, persistently and coherently.
+ * The ring is split into segments; fenceFrame() puts a fence after each frame's draws, and
+ * writing into a segment first waits for the fence of the last frame that used it (normally long
+ * signaled, since the ring holds several frames of data).
+ *
+ * On plain GL 3.3 each map() is an unsynchronized glMapBufferRange of fresh space, and the
+ * buffer is orphaned (glBufferData with no data) when the ring wraps, so the driver hands out new
+ * storage instead of waiting for draws still using the old one.
+ */
+class StreamBuffer {
+public:
+    /// @brief Creates the buffer (needs the GL context).
+    /// @param capacity Size of the ring in bytes
+    explicit StreamBuffer(GLsizeiptr capacity);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer &) = delete;
+    StreamBuffer &operator=(const StreamBuffer &) = delete;
+
+    /// @brief The buffer shared by every streaming renderer, created on first use.
+    static StreamBuffer &shared();
+    /// @brief Deletes the shared buffer (before the GL context goes away).
+    static void releaseShared();
+
+    /// @brief Reserves bytes for writing.
+    /// @param bytes Size of the range (at most the capacity)
+    /// @param alignment The range starts at a multiple of this (use the vertex stride, so
+    /// getOffset() / stride is the first vertex to draw)
+    /// @return Where to write, or nullptr if bytes is larger than the ring
+    void *map(GLsizeiptr bytes, GLsizeiptr alignment);
+
+    /// @brief Finishes writing the range returned by the last map().
+    void unmap();
+
+    /// @brief Byte offset of the range returned by the last map().
+    GLintptr getOffset() const { return offset; }
+
+    /// @brief The GL buffer object (bind it as GL_ARRAY_BUFFER when setting up a VAO).
+    GLuint getBuffer() const { return buffer; }
+
+    /// @brief Whether the persistent mapped path is in use (otherwise orphaning).
+    bool isPersistent() const { return mapped != nullptr; }
+
+    /// @brief Marks the end of a frame's draws. Call once per frame, after the last draw.
+    void fenceFrame();
+
+private:
+    static constexpr int segmentCount = 8;
+
+    GLuint buffer = 0;
+    GLsizeiptr capacity;
+    GLsizeiptr segmentSize;
+    /// @brief Next free byte and the start of the last mapped range.
+    GLintptr head = 0, offset = 0;
+    /// @brief Persistent mapping of the whole buffer (null on the orphaning path).
+    unsigned char *mapped = nullptr;
+
+    /// @brief Frames are numbered from 1; the fences of frames still in flight, oldest first.
+    unsigned long frame = 1;
+    std::deque<std::pair<unsigned long, GLsync>> fences;
+    /// @brief Last frame that wrote to each segment (0 for none).
+    unsigned long segmentFrame[segmentCount] = {};
+
+    /// @brief Waits until the GPU is done with every frame up to and including lastFrame.
+    void waitForFrame(unsigned long lastFrame);
+    /// @brief Persistent path: waits for the segments [first, last] and claims them for this frame.
+    void claimSegments(GLintptr first, GLintptr last);
+
+    static std::unique_ptr<StreamBuffer> sharedBuffer;
+};
+
+#endif //RUNNER_STREAM_BUFFER_H
@@ -0,0 +1,133 @@
+#include "textureAtlas.h"
+
+#include <algorithm>
+
+SkylinePacker::SkylinePacker(int width, int height) : width(width), height(height) {
+    clear();
+}
+
+void SkylinePacker::clear() {
+    skyline.assign(1, {0, 0, width});
+    usedArea = 0;
+}
+
+float SkylinePacker::occupancy() const {
+    return static_cast<float>(usedArea) / (static_cast<float>(width) * height);
+}
+
+int SkylinePacker::fit(size_t index, int rectWidth, int rectHeight) const {
+    if (skyline[index].x + rectWidth > width)
+        return -1;
+    // The rectangle rests on the highest segment it spans
+    int y = skyline[index].y;
+    for (int left = rectWidth; left > 0; left -= skyline[index++].width) {
+        y = std::max(y, skyline[index].y);
+        if (y + rectHeight > height)
+            return -1;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int rectWidth, int rectHeight, int &x, int &y) {
+    if (rectWidth <= 0 || rectHeight <= 0)
+        return false;
+    size_t best = skyline.size();
+    int bestTop = height + 1, bestWidth = width + 1, bestY = 0;
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        const int fitY = fit(i, rectWidth, rectHeight);
+        if (fitY < 0)
+            continue;
+        const int top = fitY + rectHeight;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth)) {
+            best = i;
+            bestTop = top;
+            bestWidth = skyline[i].width;
+            bestY = fitY;
+        }
+    }
+    if (best == skyline.size())
+        return false;
+
+    x = skyline[best].x;
+    y = bestY;
+    usedArea += static_cast<long>(rectWidth) * rectHeight;
+
+    // The rectangle's top becomes a segment, covering (part of) the segments under it
+    skyline.insert(skyline.begin() + best, {x, bestTop, rectWidth});
+    const int right = x + rectWidth;
+    size_t next = best + 1;
+    while (next < skyline.size() && skyline[next].x < right) {
+        const int end = skyline[next].x + skyline[next].width;
+        if (end <= right) {
+            skyline.erase(skyline.begin() + next);
+        }
+        else {
+            skyline[next].width = end - right;
+            skyline[next].x = right;
+            break;
+        }
+    }
+    // Merge neighbours at the same height so later searches see one wide segment
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+TextureAtlas::TextureAtlas(int pageSize, int padding) : pageSize(pageSize), padding(padding) {}
+
+TextureAtlas::~TextureAtlas() {
+    for (const Page &page : pages)
+        glDeleteTextures(1, &page.texture);
+}
+
+TextureAtlas::Page &TextureAtlas::addPage(int width, int height) {
+    width = std::max(width, pageSize);
+    height = std::max(height, pageSize);
+    // Start transparent: the padding between images must not contain garbage
+    const std::vector<unsigned char> clear(static_cast<size_t>(width) * height * 4, 0);
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, clear.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    pages.push_back({texture, SkylinePacker(width, height)});
+    return pages.back();
+}
+
+AtlasRegion TextureAtlas::add(const unsigned char *rgba, int width, int height) {
+    const int paddedWidth = width + 2 * padding, paddedHeight = height + 2 * padding;
+    int x = 0, y = 0;
+    size_t index = 0;
+    while (index < pages.size() && !pages[index].packer.insert(paddedWidth, paddedHeight, x, y))
+        ++index;
+    if (index == pages.size())
+        addPage(paddedWidth, paddedHeight).packer.insert(paddedWidth, paddedHeight, x, y);
+    const Page &page = pages[index];
+
+    x += padding;
+    y += padding;
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Rows are stored top first, so v grows downwards through the image
+    const float pageWidth = static_cast<float>(page.packer.getWidth());
+    const float pageHeight = static_cast<float>(page.packer.getHeight());
+    AtlasRegion region;
+    region.page = static_cast<int>(index);
+    region.uv = {x / pageWidth, y / pageHeight, (x + width) / pageWidth, (y + height) / pageHeight};
+    region.width = width;
+    region.height = height;
+    return region;
+}
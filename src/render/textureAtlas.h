@@ -0,0 +1,102 @@
+#ifndef RUNNER_TEXTURE_ATLAS_H
+#define RUNNER_TEXTURE_ATLAS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/**
+ * @brief Packs rectangles into a fixed size page, bottom-left first along a skyline.
+ * @details The skyline is the top edge of everything placed so far, as a list of horizontal
+ * segments. A rectangle goes where its top ends up lowest (ties go to the narrower segment), so
+ * the page fills from the bottom up with little wasted space for similar sized images. Pure CPU,
+ * no GL.
+ */
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+
+    /// @brief Finds room for a width x height rectangle and marks it used.
+    /// @param x,y Bottom left corner of the placed rectangle
+    /// @return false (leaving x and y alone) if it doesn't fit anywhere
+    bool insert(int width, int height, int &x, int &y);
+
+    /// @brief Forgets every rectangle.
+    void clear();
+
+    /// @brief Fraction of the page covered by placed rectangles.
+    float occupancy() const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    /// @brief A segment of the skyline: [x, x + width) at height y.
+    struct Node {
+        int x, y, width;
+    };
+
+    int width, height;
+    long usedArea = 0;
+    /// @brief Left to right, always covering [0, width).
+    std::vector<Node> skyline;
+
+    /// @brief Height a rectangle starting at skyline[index] would sit at, or -1 if it doesn't fit.
+    int fit(size_t index, int rectWidth, int rectHeight) const;
+};
+
+/// @brief Where an image ended up in a TextureAtlas.
+struct AtlasRegion {
+    /// @brief Index of the page texture (see TextureAtlas::getPageTexture)
+    int page = 0;
+    /// @brief Texture coordinates <u0, v0, u1, v1> of the image's top left and bottom right
+    glm::vec4 uv = glm::vec4(0.0f, 0.0f, 0.0f, 0.0f);
+    /// @brief Size of the image in pixels
+    int width = 0, height = 0;
+};
+
+/**
+ * @brief RGBA textures ("pages") that many small images are packed into, so sprites using any
+ * of them can be drawn together (see SpriteBatch).
+ * @details Images are placed with a SkylinePacker, one per page. When an image doesn't fit on any
+ * page a new page is started; an image larger than the page size gets a page of its own. Images
+ * are separated by transparent padding and sampled with GL_NEAREST, so pixel art stays sharp and
+ * never picks up its neighbours' edges.
+ */
+class TextureAtlas {
+public:
+    /// @brief No pages are created until the first add() (which needs the GL context).
+    /// @param pageSize Width and height of each page
+    /// @param padding Transparent pixels kept around every image
+    explicit TextureAtlas(int pageSize = 1024, int padding = 1);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+    /// @brief Copies an image into a page.
+    /// @param rgba 8-bit RGBA pixels, top row first
+    AtlasRegion add(const unsigned char *rgba, int width, int height);
+
+    /// @brief The GL texture of a page.
+    GLuint getPageTexture(int page) const { return pages[page].texture; }
+
+    /// @brief Number of pages created so far.
+    size_t getPageCount() const { return pages.size(); }
+
+private:
+    struct Page {
+        GLuint texture;
+        SkylinePacker packer;
+    };
+
+    int pageSize;
+    int padding;
+    std::vector<Page> pages;
+
+    /// @brief Creates a transparent page of at least width x height.
+    Page &addPage(int width, int height);
+};
+
+#endif //RUNNER_TEXTURE_ATLAS_H
@@ -0,0 +1,135 @@
+#include "programCache.h"
+#include "../util/profiler.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    /// @brief Start of every cache file; bump the digit if the layout changes.
+    const char fileMagic[4] = {'R', 'P', 'B', '1'};
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t format;
+        uint64_t key;
+        uint64_t length;
+    };
+
+    // 64-bit FNV-1a
+    uint64_t hashBytes(uint64_t hash, const void *data, size_t length) {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    uint64_t hashString(uint64_t hash, const std::string &text) {
+        // Length first so {"ab", "c"} and {"a", "bc"} hash differently
+        const uint64_t length = text.size();
+        hash = hashBytes(hash, &length, sizeof(length));
+        return hashBytes(hash, text.data(), text.size());
+    }
+
+    uint64_t hashGlString(uint64_t hash, GLenum name) {
+        const GLubyte *text = glGetString(name);
+        return hashString(hash, text ? reinterpret_cast<const char *>(text) : "");
+    }
+}
+
+ProgramCache::ProgramCache(std::string directory) : directory(std::move(directory)) {}
+
+bool ProgramCache::isEnabled() {
+    if (supported < 0) {
+        GLint formats = 0;
+        const bool hasBinaries = GLAD_GL_ARB_get_program_binary ||
+                                 GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+        if (hasBinaries)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = !directory.empty() && formats > 0;
+        if (supported) {
+            driverHash = 14695981039346656037ull;
+            driverHash = hashGlString(driverHash, GL_VENDOR);
+            driverHash = hashGlString(driverHash, GL_RENDERER);
+            driverHash = hashGlString(driverHash, GL_VERSION);
+        }
+    }
+    return supported > 0;
+}
+
+uint64_t ProgramCache::key(const ShaderSource &source) {
+    uint64_t hash = driverHash;
+    hash = hashString(hash, source.vertex);
+    hash = hashString(hash, source.fragment);
+    hash = hashString(hash, source.hasGeometry ? source.geometry : std::string());
+    return hashBytes(hash, &source.hasGeometry, sizeof(source.hasGeometry));
+}
+
+std::string ProgramCache::pathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return directory + "/" + name;
+}
+
+bool ProgramCache::load(uint64_t key, GLuint &program) {
+    if (!isEnabled())
+        return false;
+    PROFILE_ZONE("load program binary");
+    std::ifstream file(pathFor(key), std::ios::binary);
+    if (!file)
+        return false;
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.key != key)
+        return false;
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size())))
+        return false;
+
+    GLuint loaded = glCreateProgram();
+    glProgramBinary(loaded, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(loaded, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // Usually a driver update the version string didn't reveal; recompile and overwrite
+        glDeleteProgram(loaded);
+        return false;
+    }
+    program = loaded;
+    return true;
+}
+
+void ProgramCache::store(uint64_t key, GLuint program) {
+    if (!isEnabled())
+        return;
+    PROFILE_ZONE("store program binary");
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    const std::string path = pathFor(key);
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        FileHeader header{};
+        std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+        header.format = format;
+        header.key = key;
+        header.length = static_cast<uint64_t>(length);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file)
+            return;
+    }
+    std::filesystem::rename(temporary, path, error);
+}
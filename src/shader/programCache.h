@@ -0,0 +1,55 @@
+#ifndef RUNNER_PROGRAM_CACHE_H
+#define RUNNER_PROGRAM_CACHE_H
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <string>
+
+#include "shaderManager.h"
+
+/**
+ * @brief On-disk cache of linked shader programs (glGetProgramBinary/glProgramBinary).
+ * @details Each program is stored in its own file named after a hash of its source code and the
+ * driver's vendor, renderer and version strings, so editing a shader or updating the driver just
+ * misses the cache. A binary the driver rejects (glProgramBinary fails to link) is treated as a
+ * miss too: the caller compiles from source and the file is overwritten.
+ *
+ * Needs GL 4.1 or ARB_get_program_binary and at least one binary format; without them (or with
+ * an empty directory) every lookup misses and nothing is written.
+ */
+class ProgramCache {
+public:
+    /// @param directory Where binaries are kept (created on first store). Empty disables the cache.
+    explicit ProgramCache(std::string directory);
+
+    /// @brief Whether the context supports program binaries and a directory was given.
+    /// @details Queries GL on the first call, so only call with a current context.
+    bool isEnabled();
+
+    /// @brief Cache key for a program: its sources plus the driver strings.
+    uint64_t key(const ShaderSource &source);
+
+    /// @brief Creates a program from a cached binary.
+    /// @param key See key()
+    /// @param program Set to the new program on a hit
+    /// @return false on a miss (no file, stale file, or the driver rejected the binary)
+    bool load(uint64_t key, GLuint &program);
+
+    /// @brief Writes a linked program's binary to the cache.
+    /// @details The program should have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+    /// Written to a temporary file and renamed into place, so a process starting at the same time
+    /// never reads half a file.
+    void store(uint64_t key, GLuint program);
+
+private:
+    std::string directory;
+    /// @brief Hash of the driver strings, folded into every key.
+    uint64_t driverHash = 0;
+    /// @brief -1 until isEnabled() has queried the context.
+    int supported = -1;
+
+    std::string pathFor(uint64_t key) const;
+};
+
+#endif //RUNNER_PROGRAM_CACHE_H
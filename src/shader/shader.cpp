@@ -1,11 +1,13 @@
 #include "shader.h"
+#include "../util/metrics.h"
 
 Shader &Shader::use() {
     glUseProgram(this->ID);
+    Metrics::add(Metric::StateChanges);
     return *this;
 }
 
-void Shader::compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource) {
+void Shader::compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource, bool retrievable) {
     unsigned int sVertex, sFragment, gShader;
 
     // vertex Shader
@@ -34,6 +36,8 @@ void Shader::compile(const char* vertexSource, const char* fragmentSource, const
     glAttachShader(this->ID, sFragment);
     if (geometrySource != nullptr)
         glAttachShader(this->ID, gShader);
+    if (retrievable)
+        glProgramParameteri(this->ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
     glLinkProgram(this->ID);
     checkCompileErrors(this->ID, "PROGRAM");
@@ -47,39 +51,48 @@ void Shader::compile(const char* vertexSource, const char* fragmentSource, const
 
 void Shader::setFloat(const char *name, float value) const {
     glUniform1f(glGetUniformLocation(this->ID, name), value);
+    Metrics::add(Metric::UniformsSet);
 }
 
 void Shader::setInteger(const char *name, int value) const {
     glUniform1i(glGetUniformLocation(this->ID, name), value);
+    Metrics::add(Metric::UniformsSet);
 
 }
 
 void Shader::setVector2f(const char *name, float x, float y) const {
     glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+    Metrics::add(Metric::UniformsSet);
 }
 
 void Shader::setVector2f(const char *name, const glm::vec2 &value) const {
     glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    Metrics::add(Metric::UniformsSet);
 }
 
 void Shader::setVector3f(const char *name, float x, float y, float z) const {
     glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    Metrics::add(Metric::UniformsSet);
 }
 
 void Shader::setVector3f(const char *name, const glm::vec3 &value) const {
     glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    Metrics::add(Metric::UniformsSet);
 }
 
 void Shader::setVector4f(const char *name, float x, float y, float z, float w) const {
     glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    Metrics::add(Metric::UniformsSet);
 }
 
 void Shader::setVector4f(const char *name, const glm::vec4 &value) const {
     glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+    Metrics::add(Metric::UniformsSet);
 }
 
 void Shader::setMatrix4(const char *name, const glm::mat4 &matrix) const {
     glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+    Metrics::add(Metric::UniformsSet);
 }
 
 
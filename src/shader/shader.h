@@ -27,7 +27,9 @@ class Shader {
         /// @param vertexSource the source code for the vertex shader
         /// @param fragmentSource the source code for the fragment shader
         /// @param geometrySource the source code for the geometry shader (optional)
-        void compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr); // note: geometry source code is optional
+        /// @param retrievable link with GL_PROGRAM_BINARY_RETRIEVABLE_HINT so the program can be cached (see ProgramCache)
+        void compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr,
+                     bool retrievable = false); // note: geometry source code is optional
 
         // ------------------------------------------------------------------------
         // utility functions
@@ -1,14 +1,31 @@
 #include "shaderManager.h"
+#include "programCache.h"
+#include "../util/profiler.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+
+ShaderManager::ShaderManager(std::string cacheDirectory)
+    : programCache(std::make_unique<ProgramCache>(std::move(cacheDirectory))) {}
 
 ShaderManager::~ShaderManager() {
     clear();
+#ifdef __linux__
+    if (watchDescriptor >= 0)
+        close(watchDescriptor);
+#endif
 }
 
 Shader ShaderManager::loadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name) {
-    return shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
+    ShaderSource source = readShaderSource(vShaderFile, fShaderFile, gShaderFile);
+    track(name, source);
+    return shaders[name] = compileCached(source);
 }
 
 Shader &ShaderManager::getShader(std::string name) {
@@ -22,11 +39,134 @@ void ShaderManager::clear() {
         glDeleteProgram(iter.second.ID);
 }
 
-Shader ShaderManager::loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile) {
-    // 1. retrieve the vertex/fragment source code from filePath
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::string geometryCode;
+Shader ShaderManager::loadShaderFromSource(const ShaderSource &source, std::string name) {
+    track(name, source);
+    return shaders[name] = compileCached(source);
+}
+
+void ShaderManager::track(const std::string &name, const ShaderSource &source) {
+    ShaderSource &files = sourceFiles[name];
+    files.vertexPath = source.vertexPath;
+    files.fragmentPath = source.fragmentPath;
+    files.geometryPath = source.geometryPath;
+    if (watchDescriptor < 0)
+        return;
+    watchDirectoryOf(files.vertexPath);
+    watchDirectoryOf(files.fragmentPath);
+    if (!files.geometryPath.empty())
+        watchDirectoryOf(files.geometryPath);
+}
+
+void ShaderManager::watchDirectoryOf(const std::string &path) {
+#ifdef __linux__
+    const size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+    // Editors either rewrite a file in place or write a new one and rename it over the old one
+    int watch = inotify_add_watch(watchDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch >= 0)
+        watchedDirectories[watch] = directory;
+#endif
+}
+
+bool ShaderManager::enableHotReload(ReloadCallback onReload) {
+#ifdef __linux__
+    if (watchDescriptor < 0) {
+        watchDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (watchDescriptor < 0)
+            return false;
+        for (const auto &iter: sourceFiles)
+            track(iter.first, iter.second);
+    }
+    this->onReload = std::move(onReload);
+    return true;
+#else
+    (void)onReload;
+    return false;
+#endif
+}
+
+std::vector<std::string> ShaderManager::changedShaders() {
+    std::vector<std::string> changed;
+#ifdef __linux__
+    if (watchDescriptor < 0)
+        return changed;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(watchDescriptor, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            auto directory = watchedDirectories.find(event->wd);
+            if (event->len == 0 || directory == watchedDirectories.end())
+                continue;
+            const std::string path = directory->second + "/" + event->name;
+            for (const auto &iter: sourceFiles) {
+                const ShaderSource &files = iter.second;
+                if (path == files.vertexPath || path == files.fragmentPath || path == files.geometryPath) {
+                    // One save can produce several events
+                    if (std::find(changed.begin(), changed.end(), iter.first) == changed.end())
+                        changed.push_back(iter.first);
+                }
+            }
+        }
+    }
+#endif
+    return changed;
+}
+
+ShaderSource ShaderManager::sourceFor(const std::string &name) const {
+    auto files = sourceFiles.find(name);
+    if (files == sourceFiles.end())
+        return ShaderSource();
+    const ShaderSource &paths = files->second;
+    return readShaderSource(paths.vertexPath.c_str(), paths.fragmentPath.c_str(),
+                            paths.geometryPath.empty() ? nullptr : paths.geometryPath.c_str());
+}
+
+bool ShaderManager::reload(const std::string &name, const ShaderSource &source) {
+    PROFILE_ZONE("reload shader");
+    Shader shader = compileCached(source);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(shader.ID, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // Errors were printed by Shader::compile; keep drawing with the old program
+        glDeleteProgram(shader.ID);
+        std::cout << "Shader '" << name << "' failed to reload, keeping the previous version" << std::endl;
+        return false;
+    }
+    Shader &current = shaders[name];
+    glDeleteProgram(current.ID);
+    current = shader;
+    std::cout << "Reloaded shader '" << name << "'" << std::endl;
+    if (onReload)
+        onReload(name, current);
+    return true;
+}
+
+Shader ShaderManager::compileCached(const ShaderSource &source) {
+    Shader shader;
+    const bool cached = programCache->isEnabled();
+    const uint64_t key = cached ? programCache->key(source) : 0;
+    if (cached && programCache->load(key, shader.ID))
+        return shader;
+
+    PROFILE_ZONE("compile shader");
+    shader.compile(source.vertex.c_str(), source.fragment.c_str(),
+                   source.hasGeometry ? source.geometry.c_str() : nullptr, cached);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(shader.ID, GL_LINK_STATUS, &linked);
+    if (cached && linked)
+        programCache->store(key, shader.ID);
+    return shader;
+}
+
+ShaderSource ShaderManager::readShaderSource(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile) {
+    // retrieve the vertex/fragment source code from filePath
+    ShaderSource source;
+    source.vertexPath = vShaderFile;
+    source.fragmentPath = fShaderFile;
+    if (gShaderFile != nullptr)
+        source.geometryPath = gShaderFile;
     try {
         // open files
         std::ifstream vertexShaderFile(vShaderFile);
@@ -39,25 +179,20 @@ Shader ShaderManager::loadShaderFromFile(const char *vShaderFile, const char *fS
         vertexShaderFile.close();
         fragmentShaderFile.close();
         // convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+        source.vertex = vShaderStream.str();
+        source.fragment = fShaderStream.str();
         // if geometry shader path is present, also load a geometry shader
         if (gShaderFile != nullptr) {
             std::ifstream geometryShaderFile(gShaderFile);
             std::stringstream gShaderStream;
             gShaderStream << geometryShaderFile.rdbuf();
             geometryShaderFile.close();
-            geometryCode = gShaderStream.str();
+            source.geometry = gShaderStream.str();
+            source.hasGeometry = true;
         }
     }
     catch (std::exception &e) {
         std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
     }
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
-    const char *gShaderCode = geometryCode.c_str();
-    // 2. now create shader object from source code
-    Shader shader;
-    shader.compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
-    return shader;
-}
\ No newline at end of file
+    return source;
+}
@@ -3,19 +3,35 @@
 
 #include "shader.h"
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <iostream>
+#include <vector>
+
+/// @brief Shader source code read from files, ready to compile.
+struct ShaderSource {
+    std::string vertex;
+    std::string fragment;
+    std::string geometry;
+    bool hasGeometry = false;
+    /// @brief Files the source was read from (watched for hot reload)
+    std::string vertexPath, fragmentPath, geometryPath;
+};
+
+class ProgramCache;
 
 class ShaderManager {
 public:
     /// @brief Default constructor
-    ShaderManager() = default;
+    /// @param cacheDirectory Where linked programs are cached between runs (see ProgramCache), empty to always compile
+    explicit ShaderManager(std::string cacheDirectory = "");
     /// @brief Default destructor
     /// @details Clears the shaders map
     ~ShaderManager();
 
 
-    /// @brief Calls loadShaderFromFile() and stores the shader in the shaders map
+    /// @brief Reads and compiles a shader (or loads it from the program cache) and stores it in the shaders map
     /// @param vShaderFile The vertex shader file
     /// @param fShaderFile The fragment shader file
     /// @param gShaderFile The geometry shader file (optional)
@@ -23,6 +39,20 @@ public:
     /// @return The shader that was loaded
     Shader loadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name);
 
+    /// @brief Reads shader files without compiling them
+    /// @details Makes no OpenGL calls, so it can run on a worker thread (see AssetLoader)
+    /// @param vShaderFile The vertex shader file
+    /// @param fShaderFile The fragment shader file
+    /// @param gShaderFile The geometry shader file (optional)
+    /// @return The source code of each stage
+    static ShaderSource readShaderSource(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile = nullptr);
+
+    /// @brief Compiles already read source code and stores the shader in the shaders map
+    /// @param source The source code, see readShaderSource()
+    /// @param name Name used for the shader in the shaders map
+    /// @return The shader that was compiled
+    Shader loadShaderFromSource(const ShaderSource &source, std::string name);
+
     /// @brief Returns a reference to the shader with the given name in the shaders map
     /// @param name The name of the shader
     /// @return The shader with the given name
@@ -31,16 +61,53 @@ public:
      /// @brief Clears the shaders map
     void clear();
 
+    /// @brief Called with a shader's name and new program after reload() swaps it in
+    using ReloadCallback = std::function<void(const std::string &name, Shader &shader)>;
+
+    /// @brief Starts watching the source files of every shader (loaded so far and later) for changes
+    /// @details Uses inotify on the shaders' directories, so editors that save by renaming a new
+    /// file into place are picked up too. Does nothing on platforms without inotify.
+    /// @param onReload Runs after a changed shader was recompiled and swapped in; code holding a
+    /// copy of the Shader (rather than a reference) updates it here, and uniforms that were only
+    /// set once have to be set again
+    /// @return false if file watching isn't available
+    bool enableHotReload(ReloadCallback onReload);
+
+    /// @brief Names of shaders whose files changed since the last call (never blocks)
+    /// @details Reread them with sourceFor() and swap them in with reload()
+    std::vector<std::string> changedShaders();
+
+    /// @brief Rereads the files a shader was loaded from
+    /// @details Makes no OpenGL calls, so it can run on a worker thread
+    ShaderSource sourceFor(const std::string &name) const;
+
+    /// @brief Compiles new source for a loaded shader and swaps it in if it links
+    /// @details On failure the old program stays in use (the compile errors are printed).
+    /// The previous program is deleted, so only references from getShader() stay valid; copies
+    /// are updated through the callback given to enableHotReload().
+    /// @return true if the new program was swapped in
+    bool reload(const std::string &name, const ShaderSource &source);
+
 private:
     /// @brief A map of shaders, with the key being the name of the shader
     std::map<std::string, Shader> shaders;
 
-     /// @brief Loads and compiles a shader from a file
-     /// @details This function is private because we only want to load shaders from within this class
-     /// @param vShaderFile The vertex shader file
-     /// @param fShaderFile The fragment shader file
-     /// @param gShaderFile The geometry shader file (optional)
-     /// @return The shader that was loaded
-    Shader loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile=nullptr);};
+    /// @brief Program binaries from previous runs
+    std::unique_ptr<ProgramCache> programCache;
+
+    /// @brief Files each shader was loaded from, by shader name
+    std::map<std::string, ShaderSource> sourceFiles;
+    /// @brief inotify descriptor (-1 when hot reload is off) and its watched directories
+    int watchDescriptor = -1;
+    std::map<int, std::string> watchedDirectories;
+    ReloadCallback onReload;
+
+    /// @brief Records the files behind a shader and (with hot reload on) watches their directories
+    void track(const std::string &name, const ShaderSource &source);
+    void watchDirectoryOf(const std::string &path);
+
+    /// @brief Loads the program from the cache, or compiles it and stores it in the cache
+    Shader compileCached(const ShaderSource &source);
+};
 
 #endif //GRAPHICS_SHADERMANAGER_H
@@ -6,11 +6,13 @@
 
 Cloud::Cloud() {};
 
-Cloud::Cloud(Shader& shader, vec2 pos) {
-    shapes.push_back(make_unique<Circle>(shader, vec2(pos.x + 3, pos.y + 15), vec2(5, 5), vec2(-1, 0), color(1, 1, 1, 1)));
-    shapes.push_back(make_unique<Circle>(shader, vec2(pos.x - 10, pos.y + 5), vec2(5, 5), vec2(-1, 0), color(1, 1, 1, 1)));
-    shapes.push_back(make_unique<Circle>(shader, vec2(pos.x + 10, pos.y + 5), vec2(5, 5), vec2(-1, 0), color(1, 1, 1, 1)));
+Cloud::Cloud(Shader& shader, Shader& circleShader, vec2 pos) {
+    // The rectangle goes first so it is drawn while the shape shader is still bound.
+    // Puffs are 25 across, the size the old triangle-fan circles ended up drawn at.
     shapes.push_back(make_unique<Rect>(shader, pos, vec2(15, 15), color(1, 1, 1, 1)));
+    shapes.push_back(make_unique<Circle>(circleShader, vec2(pos.x + 3, pos.y + 15), vec2(25, 25), vec2(-1, 0), color(1, 1, 1, 1)));
+    shapes.push_back(make_unique<Circle>(circleShader, vec2(pos.x - 10, pos.y + 5), vec2(25, 25), vec2(-1, 0), color(1, 1, 1, 1)));
+    shapes.push_back(make_unique<Circle>(circleShader, vec2(pos.x + 10, pos.y + 5), vec2(25, 25), vec2(-1, 0), color(1, 1, 1, 1)));
 }
 
 void Cloud::setUniformsAndDraw() const {
@@ -30,5 +32,9 @@ void Cloud::moveXWithinBounds(int delta, const unsigned int width) {
 }
 
 bool Cloud::isOverlapping(const Rect& r) const {
-    return r.isOverlapping(*shapes[3]);
+    for (const unique_ptr<Shape> &s : shapes) {
+        if (r.isOverlapping(*s))
+            return true;
+    }
+    return false;
 }
\ No newline at end of file
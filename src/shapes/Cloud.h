@@ -8,9 +8,11 @@
 #include <memory>
 using std::make_unique, std::unique_ptr;
 
+// A single cloud built from Shapes. Backgrounds with many clouds use ParallaxBackground, which
+// draws the same shape instanced.
 class Cloud {
 private:
-    // Each cloud contains 3 circles and 1 rectangle
+    // Each cloud contains 1 rectangle and 3 circles (in that order)
     // Store the shapes in a vector and use polymorphism
     // to draw
     vector<unique_ptr<Shape>> shapes;
@@ -18,15 +20,16 @@ private:
 public:
     // Constructors
     Cloud();
-    Cloud(Shader& shader, vec2 pos);
+    // shader draws the rectangle, circleShader the circles
+    Cloud(Shader& shader, Shader& circleShader, vec2 pos);
 
-    // Draw the cloud
+    // Draw the cloud (the shape shader must be bound; the circle shader is bound afterwards)
     void setUniformsAndDraw() const;
 
     // This will allow us to move the clouds left and right
     void moveXWithinBounds(int delta, const unsigned int width);
 
-    // Return true if r overlaps with the rectangle in the cloud
+    // Return true if r overlaps with any part of the cloud (rectangle or puffs)
     // and false otherwise
     bool isOverlapping(const Rect& r) const;
 };
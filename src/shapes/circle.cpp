@@ -1,33 +1,25 @@
 #include "circle.h"
+#include "circleBatch.h"
+#include "collision.h"
 #include "rect.h"
+#include "../util/metrics.h"
 
 
-Circle::~Circle() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-}
-
 void Circle::setUniforms() const {
-    Shape::setUniforms(); // Sets model and shapeColor uniforms
-    shader.setFloat("radius", radius);
-    shader.setVector2f("center", pos.x, pos.y);
+    shader.use();
+    // Constant vertex attributes stand in for the instance attributes CircleBatch streams
+    glVertexAttrib2f(1, pos.x, pos.y);
+    glVertexAttrib1f(2, radius);
+    glVertexAttrib4fv(3, &fill.vec.x);
 }
 
 void Circle::draw() const {
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, segments + 2); // +2 for center and last vertex
+    glBindVertexArray(CircleBatch::singleCircleVAO());
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
-}
-
-void Circle::initVectors() {
-    // Center of circle
-    vertices.push_back(0.0f);
-    vertices.push_back(0.0f);
-    for (int i = 0; i <= segments; ++i) {
-        float theta = 2.0f * 3.1415926f * float(i) / float(segments);
-        vertices.push_back(radius * cosf(theta)); // x = r*cos(theta)
-        vertices.push_back(radius * sinf(theta)); // y = r*sin(theta)
-    }
+    Metrics::add(Metric::DrawCalls);
+    Metrics::add(Metric::Triangles, 2);
+    Metrics::add(Metric::StateChanges, 2);
 }
 
 void Circle::setRadius(float radius) {
@@ -51,5 +43,5 @@ bool Circle::isOverlapping(const Circle &c) const {
 }
 
 bool Circle::isOverlapping(const Shape& other) const {
-    return false; // placeholder value
-}
\ No newline at end of file
+    return shapesOverlap(*this, other);
+}
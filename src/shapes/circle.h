@@ -6,13 +6,13 @@
 using std::vector, glm::vec2, glm::vec3, glm::normalize, glm::dot;
 
 
+/// @brief A filled, anti-aliased circle.
+/// @details Has no vertices of its own: it is drawn as the quad shared by every circle, cut out
+/// by the circle shader (res/shaders/circle.*). Draw many at once with a CircleBatch.
 class Circle : public Shape {
 private:
 
-    /// @brief Number of x,y points to draw the circle
-    const static int segments = 100;
-
-    /// @brief Radius of the circle (half of screen width
+    /// @brief Radius of the circle (half of size.x)
     float radius;
     /// @brief The x and y velocities of the circle
     vec2 velocity;
@@ -21,12 +21,9 @@ public:
     /// @brief Construct a new Circle object
     /// @details This is the main constructor for the Circle class.
     /// @details All other constructors call this constructor.
+    /// @param shader The circle shader, not the shape shader
     Circle(Shader &shader, vec2 pos, vec2 size, vec2 velocity, struct color color)
-        : Shape(shader, pos, size, color), radius(size.x / 2.0f), velocity(velocity) {
-        initVectors();
-        initVAO();
-        initVBO();
-    }
+        : Shape(shader, pos, size, color, ShapeKind::Circle), radius(size.x / 2.0f), velocity(velocity) {}
 
     Circle(Shader & shader, vec2 pos, vec2 size, color c)
         : Circle(shader, pos, size, vec2(0, 0), c) {}
@@ -37,18 +34,16 @@ public:
     Circle(Shader &shader, vec2 pos, float radius, vec2 velocity, color c)
         : Circle(shader, pos, vec2(radius * 2, radius * 2), velocity, c) {}
 
-    // override setUniforms to set the radius uniform
+    /// @brief Binds the circle shader and sets this circle's center, radius and color
+    /// @details The circle shader stays bound, so use() the shape shader again before drawing
+    /// other shapes.
     void setUniforms() const override;
 
-    /// @brief Destroy the Circle object
-    /// @details destroys the VAO and VBO associated with the circle
-    ~Circle() override;
-
     /// @brief Draws the circle
     void draw() const override;
 
-    /// @brief Computes the border of the circle, and stores the vertices in the circleVertices array.
-    void initVectors();
+    /// @brief Circles have no vertices of their own (see CircleBatch::singleCircleVAO)
+    void initVectors() override {}
 
     /// @brief Returns the radius of the circle
     float getRadius() const;
@@ -71,7 +66,7 @@ public:
     /// @brief Checks if two circles are overlapping
     /// @details This function is called in Engine's update function to check if any two circles are overlapping.
     bool isOverlapping(const Circle &c) const;
-    bool isOverlapping(const Shape& other) const;
+    bool isOverlapping(const Shape& other) const override;
 };
 
 
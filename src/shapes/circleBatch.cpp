@@ -0,0 +1,104 @@
+#include "circleBatch.h"
+#include "../render/streamBuffer.h"
+#include "../util/metrics.h"
+
+#include <algorithm>
+#include <cstddef>
+
+static_assert(sizeof(CircleBatch::Instance) == 7 * sizeof(float), "instance attributes must be tightly packed");
+
+GLuint CircleBatch::sharedQuad = 0;
+GLuint CircleBatch::sharedVAO = 0;
+
+GLuint CircleBatch::quadBuffer() {
+    if (!sharedQuad) {
+        const float corners[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+        glGenBuffers(1, &sharedQuad);
+        glBindBuffer(GL_ARRAY_BUFFER, sharedQuad);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    return sharedQuad;
+}
+
+GLuint CircleBatch::singleCircleVAO() {
+    if (!sharedVAO) {
+        // Only the corners come from a buffer; center, radius and color are constant attributes
+        glGenVertexArrays(1, &sharedVAO);
+        glBindVertexArray(sharedVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, quadBuffer());
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+    return sharedVAO;
+}
+
+void CircleBatch::releaseShared() {
+    glDeleteVertexArrays(1, &sharedVAO);
+    glDeleteBuffers(1, &sharedQuad);
+    sharedVAO = sharedQuad = 0;
+}
+
+CircleBatch::CircleBatch(Shader &shader) : shader(shader) {
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, quadBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    // Instance attributes advance once per circle; their offsets are set in draw()
+    for (GLuint attribute = 1; attribute <= 3; ++attribute) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+CircleBatch::~CircleBatch() {
+    glDeleteVertexArrays(1, &VAO);
+}
+
+void CircleBatch::add(vec2 center, float radius, const color &fill) {
+    instances.push_back({center, radius, fill.vec});
+}
+
+void CircleBatch::add(const Circle &circle) {
+    add(circle.getPos(), circle.getRadius(), color(circle.getRed(), circle.getGreen(),
+                                                   circle.getBlue(), circle.getOpacity()));
+}
+
+void CircleBatch::draw() {
+    if (instances.empty())
+        return;
+    StreamBuffer &stream = StreamBuffer::shared();
+    const GLsizeiptr bytes = instances.size() * sizeof(Instance);
+    void *data = stream.map(bytes, sizeof(float));
+    if (!data) {
+        instances.clear();
+        return;
+    }
+    std::copy(instances.begin(), instances.end(), static_cast<Instance *>(data));
+    stream.unmap();
+
+    shader.use();
+    glBindVertexArray(VAO);
+    // Point the instance attributes at this draw's range of the ring
+    glBindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+    const GLintptr base = stream.getOffset();
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          (void*)(base + offsetof(Instance, center)));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          (void*)(base + offsetof(Instance, radius)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          (void*)(base + offsetof(Instance, color)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instances.size()));
+    glBindVertexArray(0);
+    Metrics::add(Metric::DrawCalls);
+    Metrics::add(Metric::Triangles, 2 * instances.size());
+    Metrics::add(Metric::StateChanges, 3);
+
+    instances.clear();
+}
@@ -0,0 +1,63 @@
+#ifndef RUNNER_CIRCLE_BATCH_H
+#define RUNNER_CIRCLE_BATCH_H
+
+#include <glad/glad.h>
+
+#include <vector>
+
+#include "circle.h"
+
+/**
+ * @brief Draws many circles with one instanced draw call.
+ * @details Every circle is the same unit quad; each instance is just a center, radius and color
+ * (28 bytes) streamed through StreamBuffer::shared(), and the circle shader (res/shaders/circle.*)
+ * cuts the circle out with its signed distance, anti-aliasing the edge. Use it for anything with
+ * many circles (cloud puffs, projectiles, particles); a single Circle draws the same way without
+ * a batch.
+ */
+class CircleBatch {
+public:
+    /// @brief Per-instance attributes, as laid out in the instance buffer.
+    struct Instance {
+        vec2 center;
+        float radius;
+        vec4 color;
+    };
+
+    /// @param shader The circle shader (its projection uniform must already be set)
+    explicit CircleBatch(Shader &shader);
+    ~CircleBatch();
+
+    CircleBatch(const CircleBatch &) = delete;
+    CircleBatch &operator=(const CircleBatch &) = delete;
+
+    /// @brief Queues a circle for the next draw().
+    void add(vec2 center, float radius, const color &fill);
+    void add(const Circle &circle);
+
+    /// @brief Number of queued circles.
+    size_t size() const { return instances.size(); }
+
+    /// @brief Draws every queued circle with the circle shader (left bound) and clears the queue.
+    void draw();
+
+    /// @brief Vertex array for drawing one circle from constant attributes (see Circle::draw).
+    /// @details Created on first use and shared by every Circle.
+    static GLuint singleCircleVAO();
+
+    /// @brief Deletes the shared quad (before the GL context goes away).
+    static void releaseShared();
+
+    /// @brief The unit quad, a triangle strip of 4 corners from -1 to 1 shared by every circle
+    /// (and anything else drawn as signed distance quads, see ParallaxBackground).
+    static GLuint quadBuffer();
+
+private:
+    Shader &shader;
+    GLuint VAO = 0;
+    std::vector<Instance> instances;
+
+    static GLuint sharedQuad, sharedVAO;
+};
+
+#endif //RUNNER_CIRCLE_BATCH_H
@@ -0,0 +1,135 @@
+#include "collision.h"
+
+#include <algorithm>
+
+namespace {
+    float cross(vec2 a, vec2 b) {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    /// @brief Interval of points projected onto axis.
+    void project(const vec2 *points, int count, vec2 axis, float &low, float &high) {
+        low = high = glm::dot(points[0], axis);
+        for (int i = 1; i < count; ++i) {
+            float d = glm::dot(points[i], axis);
+            low = std::min(low, d);
+            high = std::max(high, d);
+        }
+    }
+
+    /// @brief Separating axis test for two convex polygons, using the edge normals of both.
+    bool overlapConvex(const vec2 *first, int firstCount, const vec2 *second, int secondCount) {
+        const vec2 *polygons[2] = {first, second};
+        const int counts[2] = {firstCount, secondCount};
+        for (int p = 0; p < 2; ++p) {
+            for (int i = 0; i < counts[p]; ++i) {
+                vec2 edge = polygons[p][(i + 1) % counts[p]] - polygons[p][i];
+                vec2 axis(-edge.y, edge.x);
+                float lowA, highA, lowB, highB;
+                project(first, firstCount, axis, lowA, highA);
+                project(second, secondCount, axis, lowB, highB);
+                if (highA < lowB || highB < lowA)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Squared distance from point to the segment [a, b].
+    float distanceToSegmentSquared(vec2 point, vec2 a, vec2 b) {
+        vec2 edge = b - a;
+        float length = glm::dot(edge, edge);
+        float t = length > 0.0f ? glm::clamp(glm::dot(point - a, edge) / length, 0.0f, 1.0f) : 0.0f;
+        vec2 offset = point - (a + edge * t);
+        return glm::dot(offset, offset);
+    }
+
+    bool insideTriangle(vec2 point, const CollisionTriangle &triangle) {
+        float ab = cross(triangle.b - triangle.a, point - triangle.a);
+        float bc = cross(triangle.c - triangle.b, point - triangle.b);
+        float ca = cross(triangle.a - triangle.c, point - triangle.c);
+        // Same side of every edge, whichever the winding
+        return (ab >= 0 && bc >= 0 && ca >= 0) || (ab <= 0 && bc <= 0 && ca <= 0);
+    }
+
+    // Table entries: geometry out of each shape, then the plain test. The table only calls an
+    // entry for the kinds in its slot, so the shapes never need to be cast.
+    using Narrowphase = bool (*)(const Shape &, const Shape &);
+
+    bool rectRect(const Shape &a, const Shape &b)         { return overlapBoxBox(aabbOf(a), aabbOf(b)); }
+    bool rectCircle(const Shape &a, const Shape &b)       { return overlapBoxDisc(aabbOf(a), discOf(b)); }
+    bool rectTriangle(const Shape &a, const Shape &b)     { return overlapBoxTriangle(aabbOf(a), triangleOf(b)); }
+    bool circleRect(const Shape &a, const Shape &b)       { return rectCircle(b, a); }
+    bool circleCircle(const Shape &a, const Shape &b)     { return overlapDiscDisc(discOf(a), discOf(b)); }
+    bool circleTriangle(const Shape &a, const Shape &b)   { return overlapDiscTriangle(discOf(a), triangleOf(b)); }
+    bool triangleRect(const Shape &a, const Shape &b)     { return rectTriangle(b, a); }
+    bool triangleCircle(const Shape &a, const Shape &b)   { return circleTriangle(b, a); }
+    bool triangleTriangle(const Shape &a, const Shape &b) { return overlapTriangleTriangle(triangleOf(a), triangleOf(b)); }
+
+    constexpr int kindCount = static_cast<int>(ShapeKind::Count);
+
+    // Rows: first shape's kind, columns: second shape's kind (ShapeKind order)
+    const Narrowphase narrowphase[kindCount][kindCount] = {
+        {rectRect,     rectCircle,     rectTriangle},
+        {circleRect,   circleCircle,   circleTriangle},
+        {triangleRect, triangleCircle, triangleTriangle},
+    };
+}
+
+bool overlapBoxBox(const CollisionAabb &first, const CollisionAabb &second) {
+    return !(first.max.x < second.min.x || first.min.x > second.max.x ||
+             first.min.y > second.max.y || first.max.y < second.min.y);
+}
+
+bool overlapBoxDisc(const CollisionAabb &box, const CollisionDisc &disc) {
+    // Closest point of the box to the center
+    vec2 offset = disc.center - glm::clamp(disc.center, box.min, box.max);
+    return glm::dot(offset, offset) <= disc.radius * disc.radius;
+}
+
+bool overlapDiscDisc(const CollisionDisc &first, const CollisionDisc &second) {
+    vec2 offset = second.center - first.center;
+    float radiusSum = first.radius + second.radius;
+    return glm::dot(offset, offset) < radiusSum * radiusSum;
+}
+
+bool overlapBoxTriangle(const CollisionAabb &box, const CollisionTriangle &triangle) {
+    const vec2 corners[4] = {box.min, {box.max.x, box.min.y}, box.max, {box.min.x, box.max.y}};
+    const vec2 points[3] = {triangle.a, triangle.b, triangle.c};
+    return overlapConvex(corners, 4, points, 3);
+}
+
+bool overlapDiscTriangle(const CollisionDisc &disc, const CollisionTriangle &triangle) {
+    if (insideTriangle(disc.center, triangle))
+        return true;
+    const float radiusSquared = disc.radius * disc.radius;
+    return distanceToSegmentSquared(disc.center, triangle.a, triangle.b) <= radiusSquared ||
+           distanceToSegmentSquared(disc.center, triangle.b, triangle.c) <= radiusSquared ||
+           distanceToSegmentSquared(disc.center, triangle.c, triangle.a) <= radiusSquared;
+}
+
+bool overlapTriangleTriangle(const CollisionTriangle &first, const CollisionTriangle &second) {
+    const vec2 a[3] = {first.a, first.b, first.c};
+    const vec2 b[3] = {second.a, second.b, second.c};
+    return overlapConvex(a, 3, b, 3);
+}
+
+CollisionAabb aabbOf(const Shape &shape) {
+    const vec2 half = shape.getSize() / 2.0f;
+    return {shape.getPos() - half, shape.getPos() + half};
+}
+
+CollisionDisc discOf(const Shape &shape) {
+    return {shape.getPos(), shape.getSize().x / 2.0f};
+}
+
+CollisionTriangle triangleOf(const Shape &shape) {
+    // Same corners as Triangle::initVectors, scaled by size around pos
+    const vec2 pos = shape.getPos();
+    const vec2 half = shape.getSize() / 2.0f;
+    return {pos + vec2(-half.x, -half.y), pos + vec2(half.x, -half.y), pos + vec2(0.0f, half.y)};
+}
+
+bool shapesOverlap(const Shape &first, const Shape &second) {
+    return narrowphase[static_cast<int>(first.getKind())][static_cast<int>(second.getKind())](first, second);
+}
@@ -0,0 +1,51 @@
+#ifndef RUNNER_COLLISION_H
+#define RUNNER_COLLISION_H
+
+#include <glm/glm.hpp>
+
+#include "shape.h"
+
+using glm::vec2;
+
+/*
+ * Narrowphase overlap tests on plain geometry, and shapesOverlap() which picks the right one for
+ * two Shapes from a table indexed by their ShapeKinds (no RTTI). Touching counts as overlapping
+ * everywhere except circle-circle, which keeps Circle's original strict test.
+ */
+
+/// @brief Axis-aligned box.
+struct CollisionAabb {
+    vec2 min;
+    vec2 max;
+};
+
+/// @brief Circle.
+struct CollisionDisc {
+    vec2 center;
+    float radius;
+};
+
+/// @brief Triangle (either winding).
+struct CollisionTriangle {
+    vec2 a, b, c;
+};
+
+bool overlapBoxBox(const CollisionAabb &first, const CollisionAabb &second);
+bool overlapBoxDisc(const CollisionAabb &box, const CollisionDisc &disc);
+bool overlapDiscDisc(const CollisionDisc &first, const CollisionDisc &second);
+bool overlapBoxTriangle(const CollisionAabb &box, const CollisionTriangle &triangle);
+bool overlapDiscTriangle(const CollisionDisc &disc, const CollisionTriangle &triangle);
+bool overlapTriangleTriangle(const CollisionTriangle &first, const CollisionTriangle &second);
+
+/// @brief The box a Rect-kind shape collides as (also every shape's bounds).
+CollisionAabb aabbOf(const Shape &shape);
+/// @brief The circle a Circle-kind shape collides as.
+CollisionDisc discOf(const Shape &shape);
+/// @brief The triangle a Triangle-kind shape collides as.
+CollisionTriangle triangleOf(const Shape &shape);
+
+/// @brief Whether two shapes of any kinds overlap.
+/// @details One lookup in a ShapeKind x ShapeKind table of narrowphase functions.
+bool shapesOverlap(const Shape &first, const Shape &second);
+
+#endif //RUNNER_COLLISION_H
@@ -0,0 +1,98 @@
+#include "parallaxBackground.h"
+#include "circleBatch.h"
+#include "../render/streamBuffer.h"
+#include "../util/metrics.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+    /// @brief Half the width of a cloud at scale 1 (matches boundsHalf in cloud.vert).
+    const float cloudHalfWidth = 23.5f;
+}
+
+ParallaxBackground::ParallaxBackground(Shader &shader, float width) : shader(shader), width(width) {
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, CircleBatch::quadBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    // x and y advance once per cloud; their offsets are set in draw()
+    for (GLuint attribute = 1; attribute <= 2; ++attribute) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+ParallaxBackground::~ParallaxBackground() {
+    glDeleteVertexArrays(1, &VAO);
+}
+
+size_t ParallaxBackground::addLayer(const LayerStyle &style, size_t cloudCount, float minY,
+                                    float maxY, unsigned int seed) {
+    std::minstd_rand random(seed);
+    std::uniform_real_distribution<float> across(0.0f, width);
+    std::uniform_real_distribution<float> up(minY, maxY);
+    Layer layer{style, {}, {}};
+    layer.x.reserve(cloudCount);
+    layer.y.reserve(cloudCount);
+    for (size_t i = 0; i < cloudCount; ++i) {
+        layer.x.push_back(across(random));
+        layer.y.push_back(up(random));
+    }
+    layers.push_back(std::move(layer));
+    return layers.size() - 1;
+}
+
+void ParallaxBackground::update(float deltaTime) {
+    for (Layer &layer : layers) {
+        // Clouds live in [-margin, width + margin), entering and leaving fully off screen
+        const float margin = cloudHalfWidth * layer.style.scale;
+        const float left = -margin;
+        const float span = width + 2.0f * margin;
+        const float shift = layer.style.speed * deltaTime;
+        float *x = layer.x.data();
+        const size_t count = layer.x.size();
+        // A select rather than a branch, so it vectorizes (see parallaxBackground.cpp in
+        // CMakeLists.txt)
+        for (size_t i = 0; i < count; ++i) {
+            const float moved = x[i] - shift;
+            x[i] = moved < left ? moved + span : moved;
+        }
+    }
+}
+
+void ParallaxBackground::draw() {
+    StreamBuffer &stream = StreamBuffer::shared();
+    shader.use();
+    glBindVertexArray(VAO);
+    for (const Layer &layer : layers) {
+        const size_t count = layer.x.size();
+        if (count == 0)
+            continue;
+        // x then y, copied straight from the layer's arrays
+        float *data = static_cast<float *>(stream.map(2 * count * sizeof(float), sizeof(float)));
+        if (!data)
+            continue;
+        std::copy(layer.x.begin(), layer.x.end(), data);
+        std::copy(layer.y.begin(), layer.y.end(), data + count);
+        stream.unmap();
+
+        const GLintptr base = stream.getOffset();
+        glBindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)base);
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float),
+                              (void*)(base + count * sizeof(float)));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        shader.setFloat("scale", layer.style.scale);
+        shader.setVector4f("cloudColor", layer.style.tint.vec);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+        Metrics::add(Metric::DrawCalls);
+        Metrics::add(Metric::Triangles, 2 * count);
+        Metrics::add(Metric::StateChanges);
+    }
+    glBindVertexArray(0);
+    Metrics::add(Metric::StateChanges, 2);
+}
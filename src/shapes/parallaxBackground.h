@@ -0,0 +1,71 @@
+#ifndef RUNNER_PARALLAX_BACKGROUND_H
+#define RUNNER_PARALLAX_BACKGROUND_H
+
+#include <glad/glad.h>
+
+#include <vector>
+
+#include "shape.h"
+
+/**
+ * @brief Layers of Cloud-shaped clouds drifting left at different speeds.
+ * @details Each layer keeps its clouds' positions in two contiguous arrays (x and y), moves and
+ * wraps them in one branch-free loop the compiler vectorizes, and draws them with one instanced
+ * draw of the cloud shader (res/shaders/cloud.*), which cuts out Cloud's body and three puffs by
+ * their signed distances. Nothing per cloud lives on the GPU; positions are streamed each frame.
+ *
+ * Add far layers first: layers draw in the order they were added.
+ */
+class ParallaxBackground {
+public:
+    /// @brief How a layer looks and moves.
+    struct LayerStyle {
+        /// @brief Leftward drift in pixels per second (far layers drift slower)
+        float speed;
+        /// @brief Size relative to a Cloud
+        float scale;
+        /// @brief Color and opacity of every cloud in the layer
+        color tint;
+    };
+
+    /// @param shader The cloud shader (its projection uniform must already be set)
+    /// @param width Width of the screen the clouds wrap around
+    ParallaxBackground(Shader &shader, float width);
+    ~ParallaxBackground();
+
+    ParallaxBackground(const ParallaxBackground &) = delete;
+    ParallaxBackground &operator=(const ParallaxBackground &) = delete;
+
+    /// @brief Adds a layer of randomly placed clouds in front of the existing ones.
+    /// @param style Speed, size and color of the layer
+    /// @param cloudCount Number of clouds
+    /// @param minY Lowest cloud position
+    /// @param maxY Highest cloud position
+    /// @param seed The same seed always places the clouds the same way
+    /// @return Index of the new layer
+    size_t addLayer(const LayerStyle &style, size_t cloudCount, float minY, float maxY,
+                    unsigned int seed);
+
+    /// @brief Drifts every cloud, wrapping clouds that leave on the left back in on the right.
+    void update(float deltaTime);
+
+    /// @brief Draws every layer (one draw call each), leaving the cloud shader bound.
+    void draw();
+
+    size_t getLayerCount() const { return layers.size(); }
+    size_t getCloudCount(size_t layer) const { return layers[layer].x.size(); }
+
+private:
+    struct Layer {
+        LayerStyle style;
+        std::vector<float> x;
+        std::vector<float> y;
+    };
+
+    Shader &shader;
+    float width;
+    GLuint VAO = 0;
+    std::vector<Layer> layers;
+};
+
+#endif //RUNNER_PARALLAX_BACKGROUND_H
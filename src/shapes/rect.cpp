@@ -1,7 +1,9 @@
 #include "rect.h"
+#include "collision.h"
+#include "../util/metrics.h"
 
 Rect::Rect(Shader & shader, vec2 pos, vec2 size, struct color color)
-    : Shape(shader, pos, size, color) {
+    : Shape(shader, pos, size, color, ShapeKind::Rect) {
     initVectors();
     initVAO();
     initVBO();
@@ -24,6 +26,9 @@ void Rect::draw() const {
     glBindVertexArray(VAO);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+    Metrics::add(Metric::DrawCalls);
+    Metrics::add(Metric::Triangles, 2);
+    Metrics::add(Metric::StateChanges, 2);
 }
 
 void Rect::initVectors() {
@@ -60,10 +65,6 @@ bool Rect::isOverlapping(const Rect &other) const {
 }
 
 bool Rect::isOverlapping(const Shape &other) const {
-    // Dynamic cast to check if the other shape is a Rect
-    const Rect* otherRect = dynamic_cast<const Rect*>(&other);
-    if (otherRect) {
-        return isOverlapping(*this, *otherRect);
-    }
-    return false;
-}
\ No newline at end of file
+    // Any kind of shape, see collision.cpp
+    return shapesOverlap(*this, other);
+}
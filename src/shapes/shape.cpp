@@ -1,10 +1,10 @@
 #include "shape.h"
 
-Shape::Shape(Shader &shader, glm::vec2 pos, glm::vec2 size, color c) :
-    shader(shader), pos(pos), size(size), fill(c) {}
+Shape::Shape(Shader &shader, glm::vec2 pos, glm::vec2 size, color c, ShapeKind kind) :
+    shader(shader), pos(pos), size(size), fill(c), kind(kind) {}
 
 Shape::Shape(Shape const& other) :
-    shader(other.shader), pos(other.pos), size(other.size), fill(other.fill) {}
+    shader(other.shader), pos(other.pos), size(other.size), fill(other.fill), kind(other.kind) {}
 
 // Initialize VAO
 unsigned int Shape::initVAO() {
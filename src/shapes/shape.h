@@ -2,6 +2,7 @@
 #define GRAPHICS_SHAPE_H
 
 #include "glm/glm.hpp"
+#include <cstdint>
 #include <vector>
 #include "../shader/shader.h"
 
@@ -29,6 +30,17 @@ struct color {
 };
 
 
+/// @brief Geometry a shape collides as (see shapes/collision.h).
+enum class ShapeKind : uint8_t {
+    /// @brief Axis-aligned box of size centered on pos (Rect, Textbox)
+    Rect,
+    /// @brief Circle of radius size.x / 2 around pos
+    Circle,
+    /// @brief Triangle with its base along the bottom of the box and its apex at the top center
+    Triangle,
+    Count
+};
+
 class Shape {
     public:
         /// @brief Construct a new Shape object
@@ -36,7 +48,8 @@ class Shape {
         /// @param pos The position of the shape
         /// @param size The size of the shape
         /// @param color The color of the shape
-        Shape(Shader& shader, vec2 pos, glm::vec2 size, color color);
+        /// @param kind The geometry the shape collides as
+        Shape(Shader& shader, vec2 pos, glm::vec2 size, color color, ShapeKind kind);
 
         /// @brief Copy constructor for Shape
         Shape(Shape const& other);
@@ -84,6 +97,9 @@ class Shape {
         // Size Functions
         vec2 getSize() const;
 
+        /// @brief The geometry the shape collides as
+        ShapeKind getKind() const { return kind; }
+
         // Velocity Functions
         vec2 getVelocity() const;
 
@@ -126,6 +142,7 @@ class Shape {
         // --------------------------------------------------------
         // Collision functions
         // --------------------------------------------------------
+        /// @brief Whether this shape overlaps another of any kind (see shapesOverlap in collision.h)
         virtual bool isOverlapping(const Shape& other) const = 0;
 
         // --------------------------------------------------------
@@ -152,6 +169,9 @@ protected:
         /// @brief The VAO of the shape
         color fill;
 
+        /// @brief The geometry the shape collides as
+        ShapeKind kind;
+
         /// @brief The Vertex Array Object, Vertex Buffer Object, and Element Buffer Object of the shape.
         unsigned int VAO, VBO, EBO;
 
@@ -3,3 +3,7 @@
 //
 
 #include "sprite.h"
+
+Sprite::Sprite(const AtlasRegion &region, vec2 pos, vec2 size)
+    : region(region), pos(pos),
+      size(size == vec2(0.0f) ? vec2(region.width, region.height) : size) {}
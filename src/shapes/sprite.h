@@ -5,12 +5,42 @@
 #ifndef SPRITE_H
 #define SPRITE_H
 
-
-
-class sprite {
-
+#include <glm/glm.hpp>
+
+#include "shape.h"
+#include "../render/textureAtlas.h"
+
+/// @brief An image from a TextureAtlas, placed, sized, rotated and tinted.
+/// @details Sprites own no GL objects and are cheap to copy; draw them with a SpriteBatch.
+class Sprite {
+public:
+    /// @param region Where the image is in the atlas
+    /// @param pos Center of the sprite
+    /// @param size Size on screen (the image's pixel size if zero)
+    Sprite(const AtlasRegion &region, vec2 pos, vec2 size = vec2(0.0f));
+
+    const AtlasRegion &getRegion() const { return region; }
+    vec2 getPos() const { return pos; }
+    vec2 getSize() const { return size; }
+    /// @brief Counterclockwise rotation about the center, in radians
+    float getRotation() const { return rotation; }
+    const color &getTint() const { return tint; }
+
+    /// @brief Shows a different image (an animation frame, say), keeping position and size.
+    void setRegion(const AtlasRegion &newRegion) { region = newRegion; }
+    void setPos(vec2 newPos) { pos = newPos; }
+    void move(vec2 offset) { pos += offset; }
+    void setSize(vec2 newSize) { size = newSize; }
+    void setRotation(float radians) { rotation = radians; }
+    /// @brief Multiplies the image's colors (white leaves it unchanged)
+    void setTint(const color &newTint) { tint = newTint; }
+
+private:
+    AtlasRegion region;
+    vec2 pos;
+    vec2 size;
+    float rotation = 0.0f;
+    color tint = color(1.0f, 1.0f, 1.0f);
 };
 
-
-
 #endif //SPRITE_H
@@ -0,0 +1,85 @@
+#include "spriteBatch.h"
+#include "circleBatch.h"
+#include "../render/streamBuffer.h"
+#include "../util/metrics.h"
+
+#include <algorithm>
+#include <cstddef>
+
+static_assert(sizeof(SpriteBatch::Instance) == 13 * sizeof(float), "instance attributes must be tightly packed");
+
+SpriteBatch::SpriteBatch(Shader &shader, const TextureAtlas &atlas) : shader(shader), atlas(atlas) {
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, CircleBatch::quadBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    // Instance attributes advance once per sprite; their offsets are set in draw()
+    for (GLuint attribute = 1; attribute <= 5; ++attribute) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+SpriteBatch::~SpriteBatch() {
+    glDeleteVertexArrays(1, &VAO);
+}
+
+void SpriteBatch::add(const Sprite &sprite) {
+    const AtlasRegion &region = sprite.getRegion();
+    if (region.page >= static_cast<int>(pages.size()))
+        pages.resize(region.page + 1);
+    pages[region.page].push_back({sprite.getPos(), sprite.getSize() / 2.0f, sprite.getRotation(),
+                                  region.uv, sprite.getTint().vec});
+    ++queued;
+}
+
+void SpriteBatch::draw() {
+    if (queued == 0)
+        return;
+    StreamBuffer &stream = StreamBuffer::shared();
+    shader.use();
+    glBindVertexArray(VAO);
+    glActiveTexture(GL_TEXTURE0);
+    for (size_t page = 0; page < pages.size(); ++page) {
+        std::vector<Instance> &instances = pages[page];
+        if (instances.empty())
+            continue;
+        glBindTexture(GL_TEXTURE_2D, atlas.getPageTexture(static_cast<int>(page)));
+        Metrics::add(Metric::StateChanges);
+        for (size_t first = 0; first < instances.size(); first += maxInstancesPerDraw) {
+            const size_t count = std::min(maxInstancesPerDraw, instances.size() - first);
+            void *data = stream.map(count * sizeof(Instance), sizeof(float));
+            if (!data)
+                break;
+            std::copy(instances.begin() + first, instances.begin() + first + count,
+                      static_cast<Instance *>(data));
+            stream.unmap();
+
+            // Point the instance attributes at this draw's range of the ring
+            glBindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+            const GLintptr base = stream.getOffset();
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  (void*)(base + offsetof(Instance, center)));
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  (void*)(base + offsetof(Instance, halfSize)));
+            glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  (void*)(base + offsetof(Instance, rotation)));
+            glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  (void*)(base + offsetof(Instance, uv)));
+            glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  (void*)(base + offsetof(Instance, tint)));
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+            Metrics::add(Metric::DrawCalls);
+            Metrics::add(Metric::Triangles, 2 * count);
+        }
+        instances.clear();
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindVertexArray(0);
+    Metrics::add(Metric::StateChanges, 2);
+    queued = 0;
+}
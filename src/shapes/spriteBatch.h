@@ -0,0 +1,60 @@
+#ifndef RUNNER_SPRITE_BATCH_H
+#define RUNNER_SPRITE_BATCH_H
+
+#include <glad/glad.h>
+
+#include <vector>
+
+#include "sprite.h"
+
+/**
+ * @brief Draws sprites with one instanced draw call per atlas page.
+ * @details Sprites are queued into a bucket per page as they are added (a counting sort, so no
+ * sort pass and each page keeps the order its sprites were added in). draw() streams each
+ * bucket's instances (center, half size, rotation, atlas rectangle and tint, 52 bytes) through
+ * StreamBuffer::shared() and draws them over the shared unit quad with the sprite shader
+ * (res/shaders/sprite.*). Pages draw in index order, so sprites that must overlap in a set
+ * order should come from the same page.
+ */
+class SpriteBatch {
+public:
+    /// @brief Per-instance attributes, as laid out in the instance buffer.
+    struct Instance {
+        vec2 center;
+        vec2 halfSize;
+        float rotation;
+        vec4 uv;
+        vec4 tint;
+    };
+
+    /// @brief Most sprites in one draw call (about 1.7 MB of instances, under half the shared
+    /// stream ring); a page with more is drawn in several.
+    static constexpr size_t maxInstancesPerDraw = 32768;
+
+    /// @param shader The sprite shader (projection set, image sampler on texture unit 0)
+    /// @param atlas Where the sprites' regions point
+    SpriteBatch(Shader &shader, const TextureAtlas &atlas);
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch &) = delete;
+    SpriteBatch &operator=(const SpriteBatch &) = delete;
+
+    /// @brief Queues a sprite for the next draw().
+    void add(const Sprite &sprite);
+
+    /// @brief Number of queued sprites.
+    size_t size() const { return queued; }
+
+    /// @brief Draws every queued sprite with the sprite shader (left bound) and clears the queue.
+    void draw();
+
+private:
+    Shader &shader;
+    const TextureAtlas &atlas;
+    GLuint VAO = 0;
+    /// @brief Queued instances, indexed by atlas page (kept allocated between frames).
+    std::vector<std::vector<Instance>> pages;
+    size_t queued = 0;
+};
+
+#endif //RUNNER_SPRITE_BATCH_H
@@ -1,4 +1,7 @@
 #include "textbox.h"
+#include "collision.h"
+#include "../util/frameArena.h"
+#include "../util/metrics.h"
 
 /*
  * This constructor takes in a few parameters, shapeShader for the background shape, textShader for
@@ -8,7 +11,7 @@
  */
 Textbox::Textbox(Shader& shapeShader, Shader& textShader, vec2 pos, vec2 size, color bgColor,
                  const string& fontPath)
-    : Shape(shapeShader, pos, size, bgColor),
+    : Shape(shapeShader, pos, size, bgColor, ShapeKind::Rect),
       text(""),
 
       textColor({1.0f, 1.0f, 1.0f, 1.0f}),
@@ -34,7 +37,18 @@ Textbox::Textbox(Shader& shapeShader, Shader& textShader, vec2 pos, vec2 size, c
 
 
 void Textbox::initTextRendering(const string& fontPath) {
-    fontRenderer = std::make_unique<FontRenderer>(textShader, fontPath, fontSize);
+    if (fontPath.empty())
+        fontRenderer = std::make_unique<FontRenderer>(textShader);
+    else
+        fontRenderer = std::make_unique<FontRenderer>(textShader, fontPath, fontSize);
+}
+
+void Textbox::setFont(std::map<char, Character> characters) {
+    fontRenderer->setFont(textShader, std::move(characters));
+}
+
+void Textbox::textShaderChanged() {
+    fontRenderer->setShader(textShader);
 }
 
 //Same as Rect.cpp/Shape, just a box.
@@ -65,25 +79,49 @@ void Textbox::draw(float deltaTime) const {
     Shape::setUniforms();
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+    Metrics::add(Metric::DrawCalls);
+    Metrics::add(Metric::Triangles, 2);
+    Metrics::add(Metric::StateChanges, 2);
     //indicator initialized for later drawing after text is finished drawing.
     indicator.setUniforms();
 
-    // Determine which text to render. Overflow text is a substring of the text field, displayed
-    // after all other text so that there is text wrapping
-    string currentText;
-    if (text.empty()) {
-        currentText = overflowText;
-    } else {
-        currentText = text;
-    }
+    //Lay out the visible text first, then render the placed glyphs
+    bool finished = layout(deltaTime);
 
-    //If there is text to render
-    if (!currentText.empty()) {
+    //If there is text to render (and the font has finished loading)
+    if (!layoutGlyphs.empty() && fontRenderer->hasFont()) {
         //Use text shader (text rendering rather than rendering shapes)
         textShader.use();
         //Setting projection for matrix, see "shader/shader.cpp" for method body (not implemented by me)
         textShader.setMatrix4("projection", projection);
 
+        for (const GlyphPlacement &glyph : layoutGlyphs) {
+            //Render the character with fontRenderer (a view of the glyph's char, no string needed)
+            fontRenderer->renderText(std::string_view(&glyph.c, 1), glyph.x, glyph.y, projection, 1.0f,
+                                     {textColor.red, textColor.green, textColor.blue});
+        }
+    }
+
+    //Simple conditional to check for the end of the drawn text/string. If there are no more characters to be rendered
+    //(Visible characters is at max length) then draw indicator and allow closing of textbox.
+    if (finished) {
+        shouldClose = true;
+        this->shader.use();
+        indicator.draw();
+    }
+}
+
+bool Textbox::layout(float deltaTime) const {
+    layoutGlyphs.clear();
+
+    // Determine which text to render. Overflow text is a substring of the text field, displayed
+    // after all other text so that there is text wrapping. Copied into the frame arena, since the
+    // loop below can move text into overflowText
+    const string &sourceText = text.empty() ? overflowText : text;
+    const ArenaString currentText(sourceText.data(), sourceText.size());
+
+    //If there is text to lay out
+    if (!currentText.empty()) {
         if (isScrolling) {
             //Using deltaTime, passed in by engine.cpp, to increment scrolling time by measurable amount of time.
             scrollElapsedTime += deltaTime;
@@ -100,8 +138,8 @@ void Textbox::draw(float deltaTime) const {
             visibleCharacters = currentText.length();
         }
 
-        //Using substring to obscure 'text' field to only display/draw text up until the amount of visiblecharacters
-        string textToRender = currentText.substr(0, visibleCharacters);
+        //Using a view of the start to obscure 'text' field to only display/draw text up until the amount of visiblecharacters
+        std::string_view textToRender = std::string_view(currentText).substr(0, visibleCharacters);
         //Using these floats to approximate width for the characters, line, and linewidth
         float charWidth = 12.5f;
         float lineHeight = 14.0f;
@@ -138,23 +176,15 @@ void Textbox::draw(float deltaTime) const {
             // Stop rendering currentText if we've reached 6 lines and move to overflow
             if (lineCount >= 6) {
                 // Move the remainder of the text into overflowText
-                overflowText = currentText.substr(i);
+                overflowText.assign(currentText.data() + i, currentText.size() - i);
                 // Clear the main text once it's fully transitioned to overflow
-                text = "";
+                text.clear();
                 visibleCharacters = 0;
             }
 
-            //Render the character with fontRenderer
-            string character(1, c);
-            //If the current character is a newline, replace it with nothing (obscure it from user)
-            if(c=='\n') {
-                character = "";
-            }
-            fontRenderer->renderText(character, currentX, currentY, projection, 1.0f,
-                                     {textColor.red, textColor.green, textColor.blue});
-            //Added this line here because even if '\n' is obscure (seen on line 150) a charWidth will still be counted for it.
-            //This ensures that all chars that are not \n have width set for them.
+            //Newlines are obscured from the user, so they get no glyph and no width
             if(c!='\n') {
+                layoutGlyphs.push_back({c, currentX, currentY});
                 // Move to the next position
                 currentX += charWidth;
             }
@@ -165,13 +195,7 @@ void Textbox::draw(float deltaTime) const {
         }
     }
 
-    //Simple conditional to check for the end of the drawn text/string. If there are no more characters to be rendered
-    //(Visible characters is at max length) then draw indicator and allow closing of textbox.
-    if (visibleCharacters >= currentText.length()) {
-        shouldClose = true;
-        this->shader.use();
-        indicator.draw();
-    }
+    return visibleCharacters >= currentText.length();
 }
 
 
@@ -221,14 +245,7 @@ void Textbox::close() {
 void Textbox::open() {
     isVisible = true;
 }
-//Used same overlap as Rect.cpp. Without implementing it I got thrown some errors.
+//Collides as a box, same as Rect (see collision.cpp)
 bool Textbox::isOverlapping(const Shape& other) const {
-    const Rect* otherRect = dynamic_cast<const Rect*>(&other);
-    if (otherRect) {
-        return !(getRight() < otherRect->getLeft() ||
-                 getLeft() > otherRect->getRight() ||
-                 getBottom() > otherRect->getTop() ||
-                 getTop() < otherRect->getBottom());
-    }
-    return false;
-}
\ No newline at end of file
+    return shapesOverlap(*this, other);
+}
@@ -9,6 +9,12 @@
 #include <string>
 #include <memory>
 
+//A single character placed by Textbox::layout(), in screen coordinates
+struct GlyphPlacement {
+    char c;
+    float x, y;
+};
+
 //textbox inherits shape
 class Textbox : public Shape {
 
@@ -37,6 +43,8 @@ private:
     mutable int visibleCharacters;
     //Projection for fontrenderer see "font/fontRenderer.cpp"
     mat4 projection;
+    //Glyphs placed by the last call to layout(), reused between frames
+    mutable std::vector<GlyphPlacement> layoutGlyphs;
 
     //Initializes fontRenderer in .cpp declaration
     void initTextRendering(const string& fontPath);
@@ -44,9 +52,17 @@ private:
 public:
     mutable bool shouldClose;
     //Constructor that takes in shapeshader and textshader for rendering, and a font path. This wont change so constant.
+    //An empty font path leaves the text invisible until setFont() is called (for fonts loaded in the background).
     Textbox(Shader& shapeShader, Shader& textShader, vec2 pos, vec2 size, color bgColor,
             const string& fontPath = "../res/fonts/MxPlus_IBM_BIOS.ttf");
 
+    //Font size the textbox renders at (what a background loaded font should be decoded at)
+    float getFontSize() const { return fontSize; }
+    //Sets glyphs uploaded after construction, see Font::decode()/Font::upload()
+    void setFont(std::map<char, Character> characters);
+    //Call after the text shader this textbox references was replaced (e.g. hot reloaded)
+    void textShaderChanged();
+
 
     void initVectors() override;
 
@@ -55,6 +71,11 @@ public:
         draw(0.0f);
     }
     void draw(float deltaTime) const;
+    //Advances scrolling by deltaTime and places the visible characters (wrapping and overflow included).
+    //Returns true once every character of the current text is visible. Called by draw().
+    bool layout(float deltaTime) const;
+    //Glyphs placed by the last layout() call
+    const std::vector<GlyphPlacement> &getLayoutGlyphs() const { return layoutGlyphs; }
 
     //open and close for textbox, simple boolean logic
     void close();
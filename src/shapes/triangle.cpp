@@ -1,7 +1,9 @@
     #include "triangle.h"
+    #include "collision.h"
+    #include "../util/metrics.h"
 
     Triangle::Triangle(Shader & shader, vec2 pos, vec2 size, struct color color)
-        : Shape(shader, pos, size, color) {
+        : Shape(shader, pos, size, color, ShapeKind::Triangle) {
         // Check if a triangle has been initialized
         initVectors();
         initVAO();
@@ -19,6 +21,9 @@
         glBindVertexArray(this->VAO);
         glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, 0);
         glBindVertexArray(0);
+        Metrics::add(Metric::DrawCalls);
+        Metrics::add(Metric::Triangles);
+        Metrics::add(Metric::StateChanges, 2);
     }
 
     void Triangle::initVectors() {
@@ -38,8 +43,8 @@
     float Triangle::getTop() const      { return pos.y + (size.y / 2); }
     float Triangle::getBottom() const   { return pos.y - (size.y / 2); }
 
-    // Is the shape overlapping the top point?
+    // Is the shape overlapping any part of the triangle? (see collision.cpp)
     bool Triangle::isOverlapping(const Shape &other) const {
-        return other.getLeft() <= pos.x && other.getRight() >= pos.x &&
-               other.getTop() >= getTop() && other.getBottom() <= getTop();
+        return shapesOverlap(*this, other);
     }
+
@@ -0,0 +1,46 @@
+#include "metrics.h"
+
+#include <cstdlib>
+#include <new>
+
+/*
+ * Global operator new/delete replacements that feed Metric::HeapAllocations, Metric::HeapBytes
+ * and the per-scope counts (see ALLOCATION_SCOPE), so the performance HUD can show how many
+ * allocations a frame makes and --check-allocations can say where they came from. The array and
+ * nothrow forms from the standard library forward to these, so replacing the plain and aligned
+ * operator new, and the plain, aligned and sized operator delete, covers everything.
+ *
+ * Compiled only with RUNNER_COUNT_ALLOCATIONS (see CMakeLists.txt).
+ */
+#ifdef RUNNER_COUNT_ALLOCATIONS
+
+void *operator new(std::size_t size) {
+    if (Metrics::countsThreadAllocations())
+        Metrics::addAllocation(size);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    if (Metrics::countsThreadAllocations())
+        Metrics::addAllocation(size);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    std::size_t rounded = (size + align - 1) / align * align;
+    if (void *ptr = std::aligned_alloc(align, rounded ? rounded : align))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+// Sized forms too, so every way of freeing goes straight to std::free (and -Wsized-deallocation
+// has nothing to warn about)
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+#endif
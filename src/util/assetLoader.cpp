@@ -0,0 +1,58 @@
+#include "assetLoader.h"
+#include "profiler.h"
+
+#include <chrono>
+#include <limits>
+
+AssetLoader::AssetLoader(JobSystem &jobs) : jobs(jobs) {}
+
+AssetLoader::~AssetLoader() {
+    jobs.wait(decodes);
+}
+
+void AssetLoader::load(Decode decode) {
+    auto request = std::make_shared<Request>();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        requests.push_back(request);
+    }
+    jobs.run(decodes, [request, decode = std::move(decode)] {
+        PROFILE_ZONE("asset decode");
+        request->upload = decode();
+        request->decoded.store(true, std::memory_order_release);
+    });
+}
+
+size_t AssetLoader::pumpUploads(double budgetSeconds) {
+    PROFILE_ZONE("asset uploads");
+    using clock = std::chrono::steady_clock;
+    const clock::time_point deadline =
+        budgetSeconds == std::numeric_limits<double>::infinity()
+            ? clock::time_point::max()
+            : clock::now() + std::chrono::duration_cast<clock::duration>(
+                                 std::chrono::duration<double>(budgetSeconds));
+    do {
+        std::shared_ptr<Request> next;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (requests.empty() || !requests.front()->decoded.load(std::memory_order_acquire))
+                break;
+            next = requests.front();
+        }
+        if (!next->upload || next->upload()) {
+            std::lock_guard<std::mutex> guard(lock);
+            requests.pop_front();
+        }
+    } while (clock::now() < deadline);
+    return pending();
+}
+
+void AssetLoader::finish() {
+    jobs.wait(decodes);
+    pumpUploads(std::numeric_limits<double>::infinity());
+}
+
+size_t AssetLoader::pending() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return requests.size();
+}
@@ -0,0 +1,62 @@
+#ifndef RUNNER_ASSET_LOADER_H
+#define RUNNER_ASSET_LOADER_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "jobSystem.h"
+
+/**
+ * @brief Streams assets in without blocking the frame.
+ * @details A load is split in two: a decode step (file reads, parsing, FreeType rasterizing...)
+ * that runs on the job system, and an upload step (creating GL objects) that must run on the GL
+ * thread. The frame calls pumpUploads() with a time budget, so uploads spread over as many frames
+ * as they need instead of causing a hitch.
+ *
+ * Uploads run in the order loads were requested, whatever order their decodes finish in, so a
+ * later load can rely on an earlier one (e.g. fonts after the text shader). An upload may also do
+ * its work in pieces: it returns false to be called again (next slice or next frame) and true once
+ * it is finished.
+ */
+class AssetLoader {
+public:
+    /// @brief GL thread step; returns true when the asset is completely uploaded.
+    using Upload = std::function<bool()>;
+    /// @brief Worker step; returns the upload to run with the decoded data.
+    using Decode = std::function<Upload()>;
+
+    explicit AssetLoader(JobSystem &jobs);
+    /// @brief Waits for running decodes. Uploads that haven't run are dropped.
+    ~AssetLoader();
+
+    /// @brief Queues a load. The decode starts right away on a worker.
+    void load(Decode decode);
+
+    /// @brief Runs pending uploads (GL thread) until budgetSeconds have passed.
+    /// @details At least one upload step runs if one is ready, so loading always progresses.
+    /// @return Loads still pending afterwards.
+    size_t pumpUploads(double budgetSeconds);
+
+    /// @brief Blocks until every requested load is decoded and uploaded (GL thread).
+    void finish();
+
+    /// @brief Number of loads not completely uploaded yet.
+    size_t pending() const;
+
+private:
+    struct Request {
+        std::atomic<bool> decoded{false};
+        Upload upload;
+    };
+
+    JobSystem &jobs;
+    JobFence decodes;
+    mutable std::mutex lock;
+    std::deque<std::shared_ptr<Request>> requests;
+};
+
+#endif //RUNNER_ASSET_LOADER_H
@@ -0,0 +1,84 @@
+#ifndef RUNNER_COMPONENT_ARRAY_H
+#define RUNNER_COMPONENT_ARRAY_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Dense storage for one component type, indexed by entity id (a sparse set).
+ * @details Values live contiguously in insertion order, so systems iterate them like a plain
+ * array; ids() gives the owner of each value. A sparse table maps ids to dense slots for O(1)
+ * has()/get(). remove() swaps the last value into the hole, so order is not stable.
+ * @tparam T Component type (plain data)
+ */
+template <typename T>
+class ComponentArray {
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    /// @brief Adds (or replaces) the component of entity id.
+    T &insert(uint32_t id, const T &value) {
+        if (id >= sparse.size())
+            sparse.resize(id + 1, npos);
+        if (sparse[id] != npos)
+            return dense[sparse[id]] = value;
+        sparse[id] = static_cast<uint32_t>(dense.size());
+        dense.push_back(value);
+        owners.push_back(id);
+        return dense.back();
+    }
+
+    /// @brief Removes entity id's component, if it has one.
+    void remove(uint32_t id) {
+        if (!has(id))
+            return;
+        uint32_t slot = sparse[id];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (slot != last) {
+            dense[slot] = dense[last];
+            owners[slot] = owners[last];
+            sparse[owners[slot]] = slot;
+        }
+        dense.pop_back();
+        owners.pop_back();
+        sparse[id] = npos;
+    }
+
+    bool has(uint32_t id) const { return id < sparse.size() && sparse[id] != npos; }
+
+    /// @brief Component of entity id (which must have one).
+    T &get(uint32_t id) { return dense[sparse[id]]; }
+    const T &get(uint32_t id) const { return dense[sparse[id]]; }
+
+    /// @brief Reserves room for count components without reallocating.
+    void reserve(size_t count) {
+        dense.reserve(count);
+        owners.reserve(count);
+    }
+
+    void clear() {
+        dense.clear();
+        owners.clear();
+        sparse.clear();
+    }
+
+    size_t size() const { return dense.size(); }
+
+    /// @brief The dense values, size() of them.
+    T *data() { return dense.data(); }
+    const T *data() const { return dense.data(); }
+    /// @brief Entity id owning each dense value.
+    const uint32_t *ids() const { return owners.data(); }
+
+    typename std::vector<T>::iterator begin() { return dense.begin(); }
+    typename std::vector<T>::iterator end() { return dense.end(); }
+    typename std::vector<T>::const_iterator begin() const { return dense.begin(); }
+    typename std::vector<T>::const_iterator end() const { return dense.end(); }
+
+private:
+    std::vector<T> dense;
+    std::vector<uint32_t> owners;
+    std::vector<uint32_t> sparse;
+};
+
+#endif //RUNNER_COMPONENT_ARRAY_H
@@ -0,0 +1,72 @@
+#include "frameArena.h"
+
+#include <cstdint>
+#include <new>
+
+namespace {
+    /// @brief Alignment of the buffer and the overflow blocks, so any alignment up to it is free.
+    const size_t blockAlignment = 64;
+
+    unsigned char *allocateBlock(size_t size) {
+        return static_cast<unsigned char *>(::operator new(size, std::align_val_t(blockAlignment)));
+    }
+
+    void freeBlock(void *block) {
+        ::operator delete(block, std::align_val_t(blockAlignment));
+    }
+}
+
+FrameArena::FrameArena(size_t capacity) : buffer(allocateBlock(capacity)), size(capacity) {}
+
+FrameArena::~FrameArena() {
+    for (void *block : overflow)
+        freeBlock(block);
+    freeBlock(buffer);
+}
+
+FrameArena &FrameArena::frame() {
+    static FrameArena arena;
+    return arena;
+}
+
+void *FrameArena::allocate(size_t bytes, size_t alignment) {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+    const uintptr_t aligned = (base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    const size_t start = static_cast<size_t>(aligned - base);
+    if (start + bytes <= size) {
+        offset = start + bytes;
+        if (offset > peak)
+            peak = offset;
+        return buffer + start;
+    }
+    // Doesn't fit: a block of its own until reset() grows the buffer
+    void *block = allocateBlock(bytes + alignment);
+    overflow.push_back(block);
+    overflowBytes += bytes;
+    const uintptr_t blockBase = reinterpret_cast<uintptr_t>(block);
+    return reinterpret_cast<void *>((blockBase + alignment - 1) & ~(uintptr_t(alignment) - 1));
+}
+
+void FrameArena::deallocate(void *ptr, size_t bytes) {
+    unsigned char *freed = static_cast<unsigned char *>(ptr);
+    if (freed >= buffer && freed + bytes == buffer + offset)
+        offset = static_cast<size_t>(freed - buffer);
+}
+
+void FrameArena::reset() {
+    if (!overflow.empty()) {
+        for (void *block : overflow)
+            freeBlock(block);
+        overflow.clear();
+        // Room for the whole of this frame next time
+        size_t grown = size ? size : blockAlignment;
+        while (grown < peak + overflowBytes)
+            grown *= 2;
+        freeBlock(buffer);
+        buffer = allocateBlock(grown);
+        size = grown;
+    }
+    offset = 0;
+    peak = 0;
+    overflowBytes = 0;
+}
@@ -0,0 +1,96 @@
+#ifndef RUNNER_FRAME_ARENA_H
+#define RUNNER_FRAME_ARENA_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Bump allocator for data that only lives until the end of the frame.
+ * @details Allocating moves an offset through one buffer; nothing is freed individually (except
+ * the most recent allocation, so a growing string or vector can reuse its own space) and reset()
+ * releases everything at once. Engine::render resets the frame arena after presenting.
+ *
+ * A frame that needs more than the buffer holds gets the extra from separate heap blocks, which
+ * reset() frees before growing the buffer to fit that frame, so the arena stops touching the heap
+ * once it has seen the largest frame.
+ *
+ * Not thread safe: frame() belongs to the main (GL) thread.
+ */
+class FrameArena {
+public:
+    /// @param capacity Size of the buffer in bytes (grows when a frame needs more)
+    explicit FrameArena(size_t capacity = 64 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /// @brief The main thread's arena, reset once per frame by Engine::render.
+    static FrameArena &frame();
+
+    /// @brief Returns size bytes aligned to alignment (a power of two), valid until reset().
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /// @brief Gives the space back if ptr was the most recent allocation, otherwise does nothing.
+    void deallocate(void *ptr, size_t size);
+
+    /// @brief Frees everything allocated since the last reset.
+    void reset();
+
+    /// @brief Bytes handed out since the last reset (including overflow blocks).
+    size_t used() const { return peak + overflowBytes; }
+
+    /// @brief Size of the buffer.
+    size_t capacity() const { return size; }
+
+private:
+    unsigned char *buffer;
+    size_t size;
+    size_t offset = 0;
+    /// @brief Highest offset reached since the last reset (deallocate() can move offset back).
+    size_t peak = 0;
+    /// @brief Heap blocks for allocations that didn't fit, freed by reset().
+    std::vector<void *> overflow;
+    size_t overflowBytes = 0;
+};
+
+/**
+ * @brief Standard allocator that takes memory from a FrameArena (the frame arena by default).
+ * @details Containers using it must not outlive the arena's next reset(). Deallocation is free,
+ * so they are for transient data built and thrown away within a frame.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : arena(&FrameArena::frame()) {}
+    ArenaAllocator(FrameArena &arena) noexcept : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.getArena()) {}
+
+    T *allocate(size_t count) {
+        return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T *ptr, size_t count) noexcept { arena->deallocate(ptr, count * sizeof(T)); }
+
+    FrameArena *getArena() const { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const { return arena != other.getArena(); }
+
+private:
+    FrameArena *arena;
+};
+
+/// @brief String in the frame arena (see ArenaAllocator).
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+/// @brief Vector in the frame arena (see ArenaAllocator).
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif //RUNNER_FRAME_ARENA_H
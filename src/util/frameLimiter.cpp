@@ -0,0 +1,37 @@
+#include "frameLimiter.h"
+
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#define RUNNER_CPU_RELAX() _mm_pause()
+#else
+#define RUNNER_CPU_RELAX() std::this_thread::yield()
+#endif
+
+constexpr std::chrono::microseconds FrameLimiter::spinThreshold;
+
+FrameLimiter::FrameLimiter(double targetFps)
+    : targetFps(targetFps),
+      period(std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / targetFps))),
+      nextDeadline(clock::now() + period) {}
+
+void FrameLimiter::wait() {
+    clock::time_point now = clock::now();
+
+    // Running behind: don't try to catch up, start a fresh schedule
+    if (now >= nextDeadline) {
+        nextDeadline = now + period;
+        return;
+    }
+
+    // Coarse sleep until shortly before the deadline...
+    if (nextDeadline - now > spinThreshold)
+        std::this_thread::sleep_for(nextDeadline - now - spinThreshold);
+
+    // ...then spin the rest of the way for sub-millisecond accuracy
+    while (clock::now() < nextDeadline)
+        RUNNER_CPU_RELAX();
+
+    nextDeadline += period;
+}
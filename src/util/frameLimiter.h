@@ -0,0 +1,34 @@
+#ifndef RUNNER_FRAME_LIMITER_H
+#define RUNNER_FRAME_LIMITER_H
+
+#include <chrono>
+
+/**
+ * @brief Caps the frame rate independently of vsync.
+ * @details wait() blocks until the next frame deadline. It sleeps for most of the remaining time
+ * and spins for the last stretch, since OS sleeps routinely overshoot by a millisecond or more,
+ * which at 144+ FPS is a large fraction of the frame.
+ */
+class FrameLimiter {
+public:
+    /// @brief Time before a deadline at which we stop sleeping and start spinning.
+    static constexpr std::chrono::microseconds spinThreshold{1500};
+
+    /// @param targetFps Frames per second to hold (must be > 0)
+    explicit FrameLimiter(double targetFps);
+
+    /// @brief Blocks until the next frame should start.
+    /// @details If a frame ran long, the schedule restarts from now instead of rushing to catch up.
+    void wait();
+
+    double getTargetFps() const { return targetFps; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    double targetFps;
+    clock::duration period;
+    clock::time_point nextDeadline;
+};
+
+#endif //RUNNER_FRAME_LIMITER_H
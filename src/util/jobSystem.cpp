@@ -0,0 +1,190 @@
+#include "jobSystem.h"
+#include "metrics.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+    // Which pool (if any) the calling thread works for, and its queue
+    thread_local const JobSystem *currentPool = nullptr;
+    thread_local size_t currentQueue = 0;
+
+    // Failed steal rounds before an idle worker goes to sleep
+    const int idleSpins = 64;
+
+    // Slots every queue starts with, enough for a frame's worth of jobs
+    const size_t initialSlots = 64;
+}
+
+JobSystem::Queue::Queue() : slots(initialSlots) {}
+
+void JobSystem::Queue::pushBack(Task task) {
+    if (count == slots.size()) {
+        // Full: unwrap into a buffer twice the size
+        std::vector<Task> grown(slots.size() * 2);
+        for (size_t i = 0; i < count; ++i)
+            grown[i] = std::move(slots[(head + i) % slots.size()]);
+        slots.swap(grown);
+        head = 0;
+    }
+    slots[(head + count) % slots.size()] = std::move(task);
+    ++count;
+}
+
+bool JobSystem::Queue::popBack(Task &task) {
+    if (count == 0)
+        return false;
+    --count;
+    task = std::move(slots[(head + count) % slots.size()]);
+    return true;
+}
+
+bool JobSystem::Queue::popFront(Task &task) {
+    if (count == 0)
+        return false;
+    task = std::move(slots[head]);
+    head = (head + 1) % slots.size();
+    --count;
+    return true;
+}
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    for (unsigned int i = 0; i <= workerCount; ++i)
+        queues.push_back(std::make_unique<Queue>());
+    for (unsigned int i = 0; i < workerCount; ++i)
+        threads.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
+unsigned int JobSystem::defaultWorkerCount() {
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+size_t JobSystem::ownQueue() const {
+    return currentPool == this ? currentQueue : queues.size() - 1;
+}
+
+void JobSystem::push(size_t queueIndex, Task task) {
+    Queue &queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.pushBack(std::move(task));
+}
+
+void JobSystem::wakeWorkers(int count) {
+    // queued was raised before this (sequentially consistent, like sleeping), and a worker raises
+    // sleeping before it checks queued: either it sees the new jobs and stays up, or this sees it
+    if (sleeping.load() == 0)
+        return;
+    // Taking the lock orders this against a worker checking `queued` before it sleeps, so the
+    // notification can't be lost
+    { std::lock_guard<std::mutex> guard(sleepLock); }
+    if (count == 1)
+        wake.notify_one();
+    else
+        wake.notify_all();
+}
+
+void JobSystem::run(JobFence &fence, Job job) {
+    fence.pending.fetch_add(1, std::memory_order_relaxed);
+    queued.fetch_add(1);
+    // Workers keep their own jobs local; other threads spread theirs over every queue
+    size_t queueIndex = currentPool == this
+                            ? currentQueue
+                            : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    push(queueIndex, {std::move(job), &fence});
+    wakeWorkers(1);
+}
+
+void JobSystem::parallelFor(JobFence &fence, size_t count, size_t grainSize, RangeJob body) {
+    if (count == 0)
+        return;
+    grainSize = std::max<size_t>(grainSize, 1);
+    // Shared by every chunk, so the body is copied once rather than per job
+    auto shared = std::make_shared<RangeJob>(std::move(body));
+    const int chunks = static_cast<int>((count + grainSize - 1) / grainSize);
+    fence.pending.fetch_add(chunks, std::memory_order_relaxed);
+    queued.fetch_add(chunks);
+    for (size_t begin = 0; begin < count; begin += grainSize) {
+        size_t end = std::min(begin + grainSize, count);
+        size_t queueIndex = currentPool == this
+                                ? currentQueue
+                                : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        push(queueIndex, {[shared, begin, end] { (*shared)(begin, end); }, &fence});
+    }
+    wakeWorkers(chunks);
+}
+
+bool JobSystem::tryRunOne(size_t queueIndex) {
+    Task task;
+    bool found = false;
+    // Own queue first, newest job
+    {
+        Queue &own = *queues[queueIndex];
+        std::lock_guard<std::mutex> guard(own.lock);
+        found = own.popBack(task);
+    }
+    // Then steal the oldest job of the other queues
+    for (size_t i = 1; !found && i < queues.size(); ++i) {
+        Queue &victim = *queues[(queueIndex + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        found = victim.popFront(task);
+    }
+    if (!found)
+        return false;
+
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    task.job();
+    task.fence->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::wait(JobFence &fence) {
+    PROFILE_ZONE("wait for jobs");
+    const size_t queueIndex = ownQueue();
+    while (!fence.done()) {
+        // Help out instead of blocking; if nothing is queued the remaining jobs are running
+        if (!tryRunOne(queueIndex))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(size_t queueIndex) {
+    currentPool = this;
+    currentQueue = queueIndex;
+    // Allocation counts belong to the main thread's frame; a job's would land in whichever frame
+    // happens to be open when it runs
+    Metrics::ignoreThreadAllocations();
+#ifdef RUNNER_PROFILING
+    Profiler::setThreadName("Worker " + std::to_string(queueIndex + 1));
+#endif
+
+    int idle = 0;
+    while (!stopping.load(std::memory_order_acquire)) {
+        if (tryRunOne(queueIndex)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < idleSpins) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleepLock);
+        sleeping.fetch_add(1);
+        wake.wait(guard, [this] {
+            return stopping.load(std::memory_order_relaxed) || queued.load() > 0;
+        });
+        sleeping.fetch_sub(1);
+        idle = 0;
+    }
+}
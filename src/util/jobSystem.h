@@ -0,0 +1,107 @@
+#ifndef RUNNER_JOB_SYSTEM_H
+#define RUNNER_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Counts the unfinished jobs of a batch. Pass it to JobSystem::run and JobSystem::wait.
+/// @details A fence can be reused once it has been waited on. It must outlive its jobs.
+class JobFence {
+public:
+    /// @brief True once every job scheduled against the fence has finished.
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+};
+
+/**
+ * @brief Work-stealing thread pool.
+ * @details Every worker owns a queue of jobs: it pops its own newest job (LIFO, cache-warm)
+ * and, when empty, steals the oldest job of another queue (FIFO, the biggest remaining work).
+ * Jobs submitted from threads outside the pool are spread round-robin over the queues, and
+ * wait() makes the waiting thread run jobs too, so a pool with zero workers still works
+ * (everything runs inside wait()). Idle workers spin briefly, then sleep on a condition
+ * variable until new jobs arrive.
+ *
+ * Wait on every fence before destroying the pool: queued jobs are dropped on shutdown.
+ * The Engine owns one (Engine::getJobs()); tools and benchmarks can create their own.
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    /// @brief Body of a parallelFor: processes items [begin, end).
+    using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+    /// @param workerCount Threads to start in addition to the threads that call wait().
+    explicit JobSystem(unsigned int workerCount = defaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /// @brief One worker per hardware thread, minus one for the main thread.
+    static unsigned int defaultWorkerCount();
+
+    unsigned int workerCount() const { return static_cast<unsigned int>(threads.size()); }
+
+    /// @brief Schedules a job against a fence.
+    void run(JobFence &fence, Job job);
+
+    /// @brief Splits [0, count) into chunks of grainSize items and schedules one job per chunk.
+    void parallelFor(JobFence &fence, size_t count, size_t grainSize, RangeJob body);
+
+    /// @brief Runs queued jobs on the calling thread until every job of the fence has finished.
+    void wait(JobFence &fence);
+
+private:
+    struct Task {
+        Job job;
+        JobFence *fence;
+    };
+
+    /// @brief One worker's jobs. The last queue belongs to threads outside the pool.
+    /// @details A ring buffer over preallocated slots, so pushing and popping never touch the
+    /// heap; it only grows (doubling) when a push finds it full.
+    struct Queue {
+        std::mutex lock;
+        std::vector<Task> slots;
+        size_t head = 0;
+        size_t count = 0;
+
+        Queue();
+        void pushBack(Task task);
+        /// @brief Newest task (the owner's end).
+        bool popBack(Task &task);
+        /// @brief Oldest task (the thieves' end).
+        bool popFront(Task &task);
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    /// @brief Jobs queued but not yet started, so idle workers know whether to sleep.
+    std::atomic<int> queued{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<unsigned int> nextQueue{0};
+    /// @brief Workers asleep on wake (or about to be), so submitters only notify when needed.
+    std::atomic<int> sleeping{0};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+
+    void push(size_t queueIndex, Task task);
+    void wakeWorkers(int count);
+    /// @brief Queue owned by the calling thread (the external queue for non-workers).
+    size_t ownQueue() const;
+    bool tryRunOne(size_t queueIndex);
+    void workerLoop(size_t queueIndex);
+};
+
+#endif //RUNNER_JOB_SYSTEM_H
@@ -0,0 +1,78 @@
+#include "metrics.h"
+
+#include <algorithm>
+
+std::array<std::atomic<uint64_t>, static_cast<int>(Metric::Count)> Metrics::counters{};
+std::array<uint64_t, static_cast<int>(Metric::Count)> Metrics::previous{};
+std::array<float, Metrics::historySize> Metrics::frameTimes{};
+int Metrics::frameCount = 0;
+thread_local bool Metrics::countThreadAllocations = true;
+std::array<std::atomic<uint64_t>, 2 * static_cast<int>(AllocationScope::Count)> Metrics::scopeCounters{};
+std::array<uint64_t, 2 * static_cast<int>(AllocationScope::Count)> Metrics::previousScopes{};
+thread_local AllocationScope Metrics::threadScope = AllocationScope::Other;
+
+void Metrics::endFrame(float frameSeconds) {
+    for (int i = 0; i < static_cast<int>(Metric::Count); ++i)
+        previous[i] = counters[i].exchange(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < scopeCounters.size(); ++i)
+        previousScopes[i] = scopeCounters[i].exchange(0, std::memory_order_relaxed);
+
+    frameTimes[frameCount % historySize] = frameSeconds * 1000.0f;
+    ++frameCount;
+}
+
+FrameTimeSummary Metrics::summarizeFrameTimes() {
+    int count = std::min(frameCount, historySize);
+    if (count == 0)
+        return {0.0f, 0.0f, 0.0f, 0.0f};
+
+    // Sort a copy on the stack so summarizing never touches the heap
+    std::array<float, historySize> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.begin() + count);
+    auto percentile = [&](float p) { return sorted[static_cast<int>(p * (count - 1))]; };
+    return {percentile(0.50f), percentile(0.95f), percentile(0.99f), sorted[count - 1]};
+}
+
+const char *Metrics::name(Metric metric) {
+    switch (metric) {
+        case Metric::DrawCalls:
+            return "Draw calls";
+        case Metric::StateChanges:
+            return "State changes";
+        case Metric::Triangles:
+            return "Triangles";
+        case Metric::UniformsSet:
+            return "Uniforms set";
+        case Metric::HeapAllocations:
+            return "Heap allocs";
+        case Metric::HeapBytes:
+            return "Heap bytes";
+        case Metric::Culled:
+            return "Culled";
+        case Metric::ArenaBytes:
+            return "Arena bytes";
+        case Metric::Count:
+            break;
+    }
+    return "";
+}
+
+const char *Metrics::name(AllocationScope scope) {
+    switch (scope) {
+        case AllocationScope::Other:
+            return "other";
+        case AllocationScope::Physics:
+            return "physics";
+        case AllocationScope::Level:
+            return "level";
+        case AllocationScope::Battle:
+            return "battle";
+        case AllocationScope::Text:
+            return "text";
+        case AllocationScope::Render:
+            return "render";
+        case AllocationScope::Count:
+            break;
+    }
+    return "";
+}
@@ -0,0 +1,151 @@
+#ifndef RUNNER_METRICS_H
+#define RUNNER_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Per-frame counters tracked by the metrics registry.
+enum class Metric {
+    DrawCalls,
+    StateChanges,
+    Triangles,
+    UniformsSet,
+    HeapAllocations,
+    /// @brief Bytes requested by those allocations
+    HeapBytes,
+    /// @brief Shapes skipped because they were outside the camera's view
+    Culled,
+    /// @brief Bytes taken from the frame arena (see frameArena.h)
+    ArenaBytes,
+    Count
+};
+
+/// @brief Subsystems heap allocations are attributed to, see ALLOCATION_SCOPE.
+enum class AllocationScope {
+    /// @brief Anything outside a tagged scope
+    Other,
+    Physics,
+    Level,
+    Battle,
+    Text,
+    Render,
+    Count
+};
+
+/// @brief Heap allocations made in one frame.
+struct AllocationStats {
+    uint64_t count;
+    uint64_t bytes;
+};
+
+/// @brief Frame time percentiles (in milliseconds) over the recent frame history.
+struct FrameTimeSummary {
+    float p50;
+    float p95;
+    float p99;
+    float worst;
+};
+
+/**
+ * @brief Global registry of per-frame counters.
+ * @details Subsystems call Metrics::add() wherever they issue draw calls, bind state, set uniforms
+ * etc. Counters are relaxed atomics so any thread can update them for the cost of one add.
+ * endFrame() snapshots the counters into the "last frame" values read by the performance HUD and
+ * records the frame time for the percentile history.
+ */
+class Metrics {
+public:
+    /// @brief Number of frames kept for frame time percentiles (about 4 seconds at 60 FPS).
+    static constexpr int historySize = 256;
+
+    /// @brief Adds to a counter for the current frame.
+    static void add(Metric metric, uint64_t amount = 1) {
+        counters[static_cast<int>(metric)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /// @brief Counts a heap allocation (HeapAllocations, HeapBytes and the calling thread's
+    /// allocation scope). Called by the operator new replacements in allocationHook.cpp.
+    static void addAllocation(size_t bytes) {
+        Metrics::add(Metric::HeapAllocations);
+        Metrics::add(Metric::HeapBytes, bytes);
+        const int scope = static_cast<int>(threadScope);
+        scopeCounters[2 * scope].fetch_add(1, std::memory_order_relaxed);
+        scopeCounters[2 * scope + 1].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /// @brief The scope the calling thread's allocations are counted against.
+    static AllocationScope currentAllocationScope() { return threadScope; }
+    /// @brief Sets the calling thread's allocation scope (use ALLOCATION_SCOPE instead).
+    static void setAllocationScope(AllocationScope scope) { threadScope = scope; }
+
+    /// @brief Allocations a scope made during the last completed frame.
+    static AllocationStats lastFrame(AllocationScope scope) {
+        const int index = 2 * static_cast<int>(scope);
+        return {previousScopes[index], previousScopes[index + 1]};
+    }
+
+    /// @brief Stops counting the calling thread's heap allocations.
+    /// @details For worker threads that aren't part of a frame (JobSystem workers, the battle
+    /// simulator), so they don't all contend on the HeapAllocations counter and a frame's count
+    /// doesn't depend on when their jobs happened to run.
+    static void ignoreThreadAllocations() { countThreadAllocations = false; }
+
+    /// @brief Whether the calling thread's heap allocations are counted (see allocationHook.cpp).
+    static bool countsThreadAllocations() { return countThreadAllocations; }
+
+    /// @brief The value a counter reached during the last completed frame.
+    static uint64_t lastFrame(Metric metric) { return previous[static_cast<int>(metric)]; }
+
+    /// @brief Closes the current frame: snapshots and resets the counters.
+    /// @param frameSeconds Duration of the frame that just ended.
+    static void endFrame(float frameSeconds);
+
+    /// @brief Frame time percentiles over the last historySize frames.
+    static FrameTimeSummary summarizeFrameTimes();
+
+    /// @brief Human readable name of a metric (for overlays and logs).
+    static const char *name(Metric metric);
+    /// @brief Human readable name of an allocation scope.
+    static const char *name(AllocationScope scope);
+
+private:
+    static std::array<std::atomic<uint64_t>, static_cast<int>(Metric::Count)> counters;
+    static std::array<uint64_t, static_cast<int>(Metric::Count)> previous;
+    static std::array<float, historySize> frameTimes;
+    static int frameCount;
+    static thread_local bool countThreadAllocations;
+    /// @brief Count then bytes of every AllocationScope.
+    static std::array<std::atomic<uint64_t>, 2 * static_cast<int>(AllocationScope::Count)> scopeCounters;
+    static std::array<uint64_t, 2 * static_cast<int>(AllocationScope::Count)> previousScopes;
+    static thread_local AllocationScope threadScope;
+};
+
+/// @brief RAII allocation scope: allocations on this thread count against scope until destroyed.
+/// @details Scopes nest; the innermost wins and the outer one is restored afterwards.
+class AllocationScopeGuard {
+public:
+    explicit AllocationScopeGuard(AllocationScope scope) : outer(Metrics::currentAllocationScope()) {
+        Metrics::setAllocationScope(scope);
+    }
+    ~AllocationScopeGuard() { Metrics::setAllocationScope(outer); }
+    AllocationScopeGuard(const AllocationScopeGuard &) = delete;
+    AllocationScopeGuard &operator=(const AllocationScopeGuard &) = delete;
+
+private:
+    AllocationScope outer;
+};
+
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b) ALLOCATION_CONCAT_INNER(a, b)
+
+#ifdef RUNNER_COUNT_ALLOCATIONS
+/// @brief Counts the allocations of the enclosing block against AllocationScope::scope.
+#define ALLOCATION_SCOPE(scope) \
+    AllocationScopeGuard ALLOCATION_CONCAT(allocationScope_, __LINE__)(AllocationScope::scope)
+#else
+#define ALLOCATION_SCOPE(scope) ((void)0)
+#endif
+
+#endif //RUNNER_METRICS_H
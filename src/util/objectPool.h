@@ -0,0 +1,157 @@
+#ifndef RUNNER_OBJECT_POOL_H
+#define RUNNER_OBJECT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// @brief Refers to an object in an ObjectPool<T>.
+/// @details An index plus the generation of the slot when the object was acquired. Releasing
+/// the object bumps the slot's generation, so old handles stop resolving instead of pointing at
+/// whatever reuses the slot. A default constructed handle refers to nothing.
+template <typename T>
+struct PoolHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == UINT32_MAX; }
+    bool operator==(const PoolHandle &other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const PoolHandle &other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Recycling pool of T, addressed by generational handles.
+ * @details Objects live in slabs of SlabSize slots, each slab one allocation aligned to a cache
+ * line, so objects never move and neighbours share cache lines. Released slots go on a free list
+ * and are handed out again (most recently released first, while still warm in the cache).
+ *
+ * Objects are constructed the first time their slot is used and then recycled: release() leaves
+ * the object constructed, and acquire() takes a reset function that it runs on every object it
+ * hands out, new or recycled, to set what the caller needs (e.g. setPos() on a Rect). This is what
+ * keeps a steady state free of heap allocations, including the ones T's own constructor makes (a
+ * Rect's vertex vectors). Objects are destroyed with the pool.
+ *
+ * Not thread safe; an object may be filled in on another thread while the pool isn't touched.
+ * @tparam T Object type (constructible from the arguments acquire() passes on)
+ * @tparam SlabSize Slots allocated at a time
+ */
+template <typename T, size_t SlabSize = 64>
+class ObjectPool {
+public:
+    using Handle = PoolHandle<T>;
+
+    ObjectPool() = default;
+    ~ObjectPool() {
+        for (size_t index = 0; index < constructedCount; ++index)
+            object(slot(index)).~T();
+        for (Slot *slab : slabs)
+            ::operator delete(slab, std::align_val_t(cacheLine));
+    }
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    /// @brief Hands out a released object if there is one, otherwise constructs one from args.
+    /// @details A recycled object keeps the state it was released with, and args are only used to
+    /// construct, so reset(T &) is called on the object either way and must set everything the
+    /// caller relies on.
+    template <typename Reset, typename... Args>
+    Handle acquire(Reset &&reset, Args &&...args) {
+        uint32_t index;
+        if (freeHead != noSlot) {
+            index = freeHead;
+            freeHead = slot(index).nextFree;
+        }
+        else {
+            index = static_cast<uint32_t>(constructedCount);
+            if (constructedCount == slabs.size() * SlabSize)
+                addSlab();
+            new (slot(index).storage) T(std::forward<Args>(args)...);
+            ++constructedCount;
+        }
+        Slot &used = slot(index);
+        reset(object(used));
+        // Odd generations are live
+        ++used.generation;
+        ++liveCount;
+        return {index, used.generation};
+    }
+
+    /// @brief Puts an object back for reuse. Stale and null handles are ignored.
+    void release(Handle handle) {
+        if (!valid(handle))
+            return;
+        Slot &freed = slot(handle.index);
+        ++freed.generation;
+        freed.nextFree = freeHead;
+        freeHead = handle.index;
+        --liveCount;
+    }
+
+    /// @brief Whether the handle still refers to a live object.
+    bool valid(Handle handle) const {
+        return handle.index < constructedCount && slot(handle.index).generation == handle.generation;
+    }
+
+    /// @brief The object, or nullptr for a stale or null handle.
+    T *get(Handle handle) { return valid(handle) ? &object(slot(handle.index)) : nullptr; }
+    const T *get(Handle handle) const { return valid(handle) ? &object(slot(handle.index)) : nullptr; }
+
+    /// @brief Allocates slabs (without constructing) until count objects fit.
+    void reserve(size_t count) {
+        while (slabs.size() * SlabSize < count)
+            addSlab();
+    }
+
+    /// @brief Number of live (acquired and not released) objects.
+    size_t size() const { return liveCount; }
+
+    /// @brief Number of objects constructed so far, live or waiting for reuse.
+    size_t constructed() const { return constructedCount; }
+
+    /// @brief Calls f(T &) for every live object, in slot order.
+    template <typename F>
+    void forEach(F f) {
+        for (size_t index = 0; index < constructedCount; ++index) {
+            Slot &current = slot(index);
+            if (current.generation & 1u)
+                f(object(current));
+        }
+    }
+
+private:
+    static constexpr size_t cacheLine = 64;
+    static constexpr uint32_t noSlot = UINT32_MAX;
+
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint32_t generation = 0;
+        uint32_t nextFree = noSlot;
+    };
+
+    std::vector<Slot *> slabs;
+    size_t constructedCount = 0;
+    size_t liveCount = 0;
+    uint32_t freeHead = noSlot;
+
+    Slot &slot(size_t index) { return slabs[index / SlabSize][index % SlabSize]; }
+    const Slot &slot(size_t index) const { return slabs[index / SlabSize][index % SlabSize]; }
+    static T &object(Slot &from) { return *std::launder(reinterpret_cast<T *>(from.storage)); }
+    static const T &object(const Slot &from) {
+        return *std::launder(reinterpret_cast<const T *>(from.storage));
+    }
+
+    void addSlab() {
+        static_assert(alignof(Slot) <= cacheLine, "slots must not need more than cache line alignment");
+        Slot *slab = static_cast<Slot *>(::operator new(sizeof(Slot) * SlabSize, std::align_val_t(cacheLine)));
+        for (size_t i = 0; i < SlabSize; ++i)
+            new (&slab[i]) Slot();
+        slabs.push_back(slab);
+    }
+};
+
+#endif //RUNNER_OBJECT_POOL_H
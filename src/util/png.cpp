@@ -0,0 +1,104 @@
+#include "png.h"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace {
+    uint32_t crcTable[256];
+
+    void initCrcTable() {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            crcTable[n] = c;
+        }
+    }
+
+    uint32_t crc32(uint32_t crc, const unsigned char *data, size_t length) {
+        crc = ~crc;
+        for (size_t i = 0; i < length; ++i)
+            crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void putBigEndian(std::vector<unsigned char> &out, uint32_t value) {
+        out.push_back(value >> 24);
+        out.push_back(value >> 16);
+        out.push_back(value >> 8);
+        out.push_back(value);
+    }
+
+    /// @brief Appends a chunk (length, type, data, CRC of type + data).
+    void writeChunk(std::ofstream &file, const char *type, const std::vector<unsigned char> &data) {
+        std::vector<unsigned char> chunk;
+        chunk.reserve(data.size() + 12);
+        putBigEndian(chunk, static_cast<uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        putBigEndian(chunk, crc32(0, chunk.data() + 4, data.size() + 4));
+        file.write(reinterpret_cast<const char *>(chunk.data()), chunk.size());
+    }
+}
+
+bool writePng(const std::string &path, const unsigned char *rgba, unsigned int width, unsigned int height) {
+    static bool crcReady = false;
+    if (!crcReady) {
+        initCrcTable();
+        crcReady = true;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char *>(signature), sizeof(signature));
+
+    // IHDR: 8 bits per channel, color type 6 (RGBA), no interlacing
+    std::vector<unsigned char> header;
+    putBigEndian(header, width);
+    putBigEndian(header, height);
+    header.insert(header.end(), {8, 6, 0, 0, 0});
+    writeChunk(file, "IHDR", header);
+
+    // Raw scanlines, each prefixed with filter type 0 (none)
+    const size_t rowSize = static_cast<size_t>(width) * 4;
+    std::vector<unsigned char> raw;
+    raw.reserve((rowSize + 1) * height);
+    for (unsigned int y = 0; y < height; ++y) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgba + y * rowSize, rgba + (y + 1) * rowSize);
+    }
+
+    // zlib stream made of stored (uncompressed) deflate blocks of at most 65535 bytes
+    std::vector<unsigned char> idat;
+    idat.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    idat.push_back(0x78);
+    idat.push_back(0x01);
+    size_t offset = 0;
+    do {
+        size_t blockSize = std::min<size_t>(65535, raw.size() - offset);
+        bool last = offset + blockSize == raw.size();
+        idat.push_back(last ? 1 : 0);
+        idat.push_back(blockSize & 0xFF);
+        idat.push_back(blockSize >> 8);
+        idat.push_back(~blockSize & 0xFF);
+        idat.push_back((~blockSize >> 8) & 0xFF);
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+    } while (offset < raw.size());
+
+    // Adler-32 of the uncompressed data
+    uint32_t a = 1, b = 0;
+    for (unsigned char byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    putBigEndian(idat, (b << 16) | a);
+    writeChunk(file, "IDAT", idat);
+
+    writeChunk(file, "IEND", {});
+    return static_cast<bool>(file);
+}
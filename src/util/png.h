@@ -0,0 +1,13 @@
+#ifndef RUNNER_PNG_H
+#define RUNNER_PNG_H
+
+#include <string>
+
+/// @brief Writes 8-bit RGBA pixels (top row first) to a PNG file.
+/// @details The image data is stored without compression, which keeps the writer dependency-free
+/// and fast. Files are larger than a real encoder would produce but decode anywhere, which is all
+/// frame dumps and CI image diffs need.
+/// @return true if the file was written.
+bool writePng(const std::string &path, const unsigned char *rgba, unsigned int width, unsigned int height);
+
+#endif //RUNNER_PNG_H
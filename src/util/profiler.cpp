@@ -0,0 +1,218 @@
+#include "profiler.h"
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+std::atomic<bool> Profiler::enabled{false};
+
+namespace {
+    /// @brief Every thread buffer that holds (or may still get) events. A buffer is registered on
+    /// its thread's first recorded zone, so threads that never record while capture is on cost
+    /// nothing. Buffers with events are kept after their thread exits, so the events survive it.
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> registry;
+    /// @brief Buffers of exited threads that never recorded anything, reused by new threads.
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> spareBuffers;
+    uint32_t nextThreadId = 1;
+
+    void retireBuffer(ProfileThreadBuffer *buffer);
+
+    /// @brief The calling thread's name and buffer. Gives the buffer back when the thread exits.
+    struct LocalThread {
+        std::string name;
+        ProfileThreadBuffer *buffer = nullptr;
+        ~LocalThread() {
+            if (buffer)
+                retireBuffer(buffer);
+        }
+    };
+    thread_local LocalThread localThread;
+
+    /// @brief Pseudo thread used to display GPU timings on their own track.
+    ProfileThreadBuffer *gpuBuffer = nullptr;
+
+    /// @brief A GL_TIME_ELAPSED query that has been issued but not read back yet.
+    struct PendingQuery {
+        GLuint query;
+        const char *name;
+        uint64_t cpuStart;
+    };
+    std::deque<PendingQuery> pendingQueries;
+    std::vector<GLuint> freeQueries;
+    bool gpuZoneOpen = false;
+
+    ProfileThreadBuffer &registerBuffer(const std::string &name) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (spareBuffers.empty()) {
+            registry.push_back(std::make_unique<ProfileThreadBuffer>());
+        }
+        else {
+            registry.push_back(std::move(spareBuffers.back()));
+            spareBuffers.pop_back();
+        }
+        ProfileThreadBuffer &buffer = *registry.back();
+        buffer.threadId = nextThreadId++;
+        buffer.threadName = name.empty() ? "Thread " + std::to_string(buffer.threadId) : name;
+        return buffer;
+    }
+
+    void retireBuffer(ProfileThreadBuffer *buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        // Recorded events stay exportable; an unused buffer can go to the next thread
+        if (buffer->head.load(std::memory_order_acquire) != 0)
+            return;
+        for (size_t i = 0; i < registry.size(); ++i) {
+            if (registry[i].get() == buffer) {
+                spareBuffers.push_back(std::move(registry[i]));
+                registry.erase(registry.begin() + i);
+                return;
+            }
+        }
+    }
+
+    void push(ProfileThreadBuffer &buffer, const char *name, uint64_t start, uint64_t end) {
+        uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        buffer.events[head & (ProfileThreadBuffer::capacity - 1)] = {name, start, end - start};
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    /// @brief Escapes quotes and backslashes for JSON output.
+    void writeJsonString(std::ofstream &out, const std::string &str) {
+        out << '"';
+        for (char c : str) {
+            if (c == '"' || c == '\\')
+                out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+}
+
+uint64_t Profiler::now() {
+    using namespace std::chrono;
+    static const steady_clock::time_point epoch = steady_clock::now();
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - epoch).count());
+}
+
+void Profiler::setEnabled(bool enable) {
+    // Touch the clock so the epoch is fixed before the first zone
+    now();
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+ProfileThreadBuffer &Profiler::threadBuffer() {
+    if (!localThread.buffer)
+        localThread.buffer = &registerBuffer(localThread.name);
+    return *localThread.buffer;
+}
+
+void Profiler::setThreadName(const std::string &name) {
+    localThread.name = name;
+    // Named before its first zone (the usual case): the name is used when the buffer is made
+    if (!localThread.buffer)
+        return;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    localThread.buffer->threadName = name;
+}
+
+void Profiler::record(const char *name, uint64_t start, uint64_t end) {
+    push(threadBuffer(), name, start, end);
+}
+
+bool Profiler::gpuBegin(const char *name) {
+    if (gpuZoneOpen)
+        return false; // GL_TIME_ELAPSED queries cannot nest
+    GLuint query;
+    if (freeQueries.empty()) {
+        glGenQueries(1, &query);
+    } else {
+        query = freeQueries.back();
+        freeQueries.pop_back();
+    }
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    pendingQueries.push_back({query, name, now()});
+    gpuZoneOpen = true;
+    return true;
+}
+
+void Profiler::gpuEnd() {
+    if (!gpuZoneOpen)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    gpuZoneOpen = false;
+}
+
+void Profiler::collectGpuTimers() {
+    if (!gpuBuffer && !pendingQueries.empty())
+        gpuBuffer = &registerBuffer("GPU");
+
+    // Queries complete in submission order, so stop at the first one that isn't ready
+    while (!pendingQueries.empty()) {
+        PendingQuery &pending = pendingQueries.front();
+        if (gpuZoneOpen && pendingQueries.size() == 1)
+            break;
+        GLint available = 0;
+        glGetQueryObjectiv(pending.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(pending.query, GL_QUERY_RESULT, &elapsed);
+        push(*gpuBuffer, pending.name, pending.cpuStart, pending.cpuStart + elapsed);
+        freeQueries.push_back(pending.query);
+        pendingQueries.pop_front();
+    }
+}
+
+void Profiler::releaseGpuTimers() {
+    for (const PendingQuery &pending : pendingQueries)
+        freeQueries.push_back(pending.query);
+    pendingQueries.clear();
+    if (!freeQueries.empty())
+        glDeleteQueries(static_cast<GLsizei>(freeQueries.size()), freeQueries.data());
+    freeQueries.clear();
+    gpuZoneOpen = false;
+}
+
+bool Profiler::writeChromeTrace(const std::string &path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "ERROR::PROFILER: Could not open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const std::unique_ptr<ProfileThreadBuffer> &buffer : registry) {
+        // Thread name metadata so tracks are labelled
+        out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+            << buffer->threadId << ",\"args\":{\"name\":";
+        writeJsonString(out, buffer->threadName);
+        out << "}}";
+        first = false;
+
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > ProfileThreadBuffer::capacity ? head - ProfileThreadBuffer::capacity : 0;
+        for (uint64_t i = begin; i < head; ++i) {
+            const ProfileEvent &event = buffer->events[i & (ProfileThreadBuffer::capacity - 1)];
+            // Chrome traces use (fractional) microseconds
+            out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ts\":" << event.start / 1000 << '.' << event.start % 1000 / 100
+                << ",\"dur\":" << event.duration / 1000 << '.' << event.duration % 1000 / 100 << '}';
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<ProfileThreadBuffer> &buffer : registry)
+        buffer->head.store(0, std::memory_order_release);
+}
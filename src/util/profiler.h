@@ -0,0 +1,136 @@
+#ifndef RUNNER_PROFILER_H
+#define RUNNER_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief A single completed timing zone.
+/// @details Times are nanoseconds since the profiler epoch (first call to Profiler::now()).
+struct ProfileEvent {
+    const char *name;
+    uint64_t start;
+    uint64_t duration;
+};
+
+/// @brief Fixed size ring of events owned by a single thread.
+/// @details Only the owning thread writes to it. Once full, the oldest events are overwritten,
+/// so a long capture keeps the most recent frames.
+struct ProfileThreadBuffer {
+    /// @brief Number of events kept per thread (power of two so the ring index is a mask).
+    static constexpr uint64_t capacity = 1 << 16;
+
+    std::vector<ProfileEvent> events;
+    std::atomic<uint64_t> head{0};
+    uint32_t threadId = 0;
+    std::string threadName;
+
+    ProfileThreadBuffer() : events(capacity) {}
+};
+
+/**
+ * @brief Lightweight scoped CPU/GPU profiler.
+ * @details CPU zones are recorded with a nanosecond steady clock into thread-local ring buffers, so
+ * recording never takes a lock. GPU zones wrap GL_TIME_ELAPSED queries which are read back a few
+ * frames later (in collectGpuTimers()) to avoid stalling the pipeline. Everything can be exported
+ * to the Chrome trace format and opened in chrome://tracing or Perfetto.
+ *
+ * Capture is off by default; zones cost one relaxed atomic load until setEnabled(true) is called.
+ * Building without RUNNER_PROFILING compiles the PROFILE_* macros out entirely.
+ */
+class Profiler {
+public:
+    /// @brief Nanoseconds since the profiler epoch.
+    static uint64_t now();
+
+    /// @brief Turn capture on or off at runtime.
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /// @brief Name the calling thread in exported traces.
+    /// @details Cheap: the thread's event buffer is only allocated when it records its first zone.
+    static void setThreadName(const std::string &name);
+
+    /// @brief Records a completed CPU zone for the calling thread.
+    /// @param name Zone name, must be a string literal (or otherwise outlive the profiler).
+    static void record(const char *name, uint64_t start, uint64_t end);
+
+    /// @brief Starts a GL_TIME_ELAPSED query. GPU zones cannot nest.
+    /// @return false (and nothing started) if a query is already open, so only the caller that
+    /// started the query ends it.
+    static bool gpuBegin(const char *name);
+    /// @brief Ends the query started by gpuBegin().
+    static void gpuEnd();
+    /// @brief Reads back any finished GPU queries and records them on the "GPU" track.
+    /// @details Call once per frame on the GL thread.
+    static void collectGpuTimers();
+    /// @brief Deletes all GL query objects. Call before the GL context is destroyed.
+    static void releaseGpuTimers();
+
+    /// @brief Writes every recorded event to a Chrome trace JSON file.
+    /// @details Should be called while no other thread is recording (e.g. at shutdown).
+    /// @return true if the file was written.
+    static bool writeChromeTrace(const std::string &path);
+
+    /// @brief Discards all recorded events.
+    static void clear();
+
+private:
+    static std::atomic<bool> enabled;
+
+    /// @brief Returns the calling thread's buffer, registering it on first use (only zones recorded
+    /// while capture is enabled get here). The buffer is released when the thread exits, unless it
+    /// holds events.
+    static ProfileThreadBuffer &threadBuffer();
+};
+
+/// @brief RAII CPU zone. Records the time between construction and destruction.
+class ProfileZone {
+public:
+    explicit ProfileZone(const char *name)
+        : name(Profiler::isEnabled() ? name : nullptr), start(this->name ? Profiler::now() : 0) {}
+    ~ProfileZone() {
+        if (name)
+            Profiler::record(name, start, Profiler::now());
+    }
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *name;
+    uint64_t start;
+};
+
+/// @brief RAII GPU zone around a GL_TIME_ELAPSED query.
+/// @details A zone nested in another GPU zone records nothing and leaves the outer query open.
+class GpuProfileZone {
+public:
+    explicit GpuProfileZone(const char *name)
+        : active(Profiler::isEnabled() && Profiler::gpuBegin(name)) {}
+    ~GpuProfileZone() {
+        if (active)
+            Profiler::gpuEnd();
+    }
+    GpuProfileZone(const GpuProfileZone &) = delete;
+    GpuProfileZone &operator=(const GpuProfileZone &) = delete;
+
+private:
+    bool active;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef RUNNER_PROFILING
+/// @brief Times the enclosing scope on the CPU.
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+/// @brief Times the enclosing scope on the GPU.
+#define PROFILE_GPU_ZONE(name) GpuProfileZone PROFILE_CONCAT(gpuProfileZone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_GPU_ZONE(name) ((void)0)
+#endif
+
+#endif //RUNNER_PROFILER_H
@@ -0,0 +1,20 @@
+#ifndef RUNNER_SEED_MIX_H
+#define RUNNER_SEED_MIX_H
+
+#include <cstdint>
+
+/// @brief Seed for one of many generators started from the same seed (a level's chunks, a
+/// simulation's battles): every bit of seed and index affects every bit of the result, so
+/// neighbouring indices and seeds get unrelated sequences.
+/// @details The 64-bit finalizer of MurmurHash3; unlike std::seed_seq it doesn't allocate.
+inline unsigned int mixSeed(unsigned int seed, uint64_t index) {
+    uint64_t x = (static_cast<uint64_t>(seed) << 32) ^ index;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<unsigned int>(x);
+}
+
+#endif //RUNNER_SEED_MIX_H
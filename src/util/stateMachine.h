@@ -0,0 +1,115 @@
+#ifndef RUNNER_STATE_MACHINE_H
+#define RUNNER_STATE_MACHINE_H
+
+/**
+ * @brief Table-driven finite state machine.
+ * @details States and events are enum classes ending in a Count enumerator. The transition table is
+ * plain data (function pointers, no allocation) built once and shared by every machine using it;
+ * a machine itself is just a pointer to its table and the current state.
+ *
+ * dispatch() is a single table lookup. On a valid transition the transition's action runs, then
+ * the target state is chosen (fixed, or by a selector for conditional transitions), then the old
+ * state's exit action and the new state's enter action run. A transition back into the same state
+ * is internal: only its action runs.
+ *
+ * @tparam State enum class of states, last enumerator Count
+ * @tparam Event enum class of events, last enumerator Count
+ * @tparam Context object actions operate on
+ */
+template <typename State, typename Event, typename Context>
+class StateMachine {
+public:
+    static constexpr int stateCount = static_cast<int>(State::Count);
+    static constexpr int eventCount = static_cast<int>(Event::Count);
+
+    /// @brief Enter/exit/transition action.
+    using Action = void (*)(Context &);
+    /// @brief Picks the target of a conditional transition (runs after the transition's action).
+    using Selector = State (*)(const Context &);
+
+    struct StateInfo {
+        const char *name = "";
+        Action onEnter = nullptr;
+        Action onExit = nullptr;
+    };
+
+    struct Transition {
+        bool valid = false;
+        State target{};
+        Action action = nullptr;
+        Selector select = nullptr;
+    };
+
+    /// @brief States and transitions. Build once (usually as a function-local static).
+    struct Table {
+        StateInfo states[stateCount];
+        Transition transitions[stateCount][eventCount];
+
+        /// @brief Names a state and sets its enter/exit actions.
+        Table &state(State s, const char *name, Action onEnter = nullptr, Action onExit = nullptr) {
+            states[index(s)] = {name, onEnter, onExit};
+            return *this;
+        }
+
+        /// @brief Adds a transition to a fixed target.
+        Table &on(State from, Event event, State to, Action action = nullptr) {
+            transitions[index(from)][index(event)] = {true, to, action, nullptr};
+            return *this;
+        }
+
+        /// @brief Adds a conditional transition whose target is picked by select.
+        Table &on(State from, Event event, Selector select, Action action = nullptr) {
+            transitions[index(from)][index(event)] = {true, from, action, select};
+            return *this;
+        }
+    };
+
+    StateMachine(const Table &table, State initial) : table(&table), current(initial) {}
+
+    /// @brief Runs the initial state's enter action.
+    void start(Context &context) {
+        enter(current, context);
+    }
+
+    /// @brief Feeds an event to the machine.
+    /// @return true if the current state had a transition for the event.
+    bool dispatch(Event event, Context &context) {
+        const Transition &transition = table->transitions[index(current)][index(event)];
+        if (!transition.valid)
+            return false;
+        if (transition.action)
+            transition.action(context);
+        State next = transition.select ? transition.select(context) : transition.target;
+        if (next != current) {
+            if (Action onExit = table->states[index(current)].onExit)
+                onExit(context);
+            current = next;
+            enter(current, context);
+        }
+        return true;
+    }
+
+    /// @brief Forces the machine into a state, running enter (but not exit) actions.
+    void reset(State state, Context &context) {
+        current = state;
+        enter(current, context);
+    }
+
+    State getState() const { return current; }
+
+    const char *getStateName() const { return table->states[index(current)].name; }
+
+private:
+    const Table *table;
+    State current;
+
+    template <typename Enum>
+    static constexpr int index(Enum value) { return static_cast<int>(value); }
+
+    void enter(State state, Context &context) {
+        if (Action onEnter = table->states[index(state)].onEnter)
+            onEnter(context);
+    }
+};
+
+#endif //RUNNER_STATE_MACHINE_H
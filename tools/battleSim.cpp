@@ -0,0 +1,224 @@
+#include "game/combatRandom.h"
+#include "game/gameStateMachine.h"
+#include "util/metrics.h"
+#include "util/seedMix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/*
+ * Headless battle simulator for balancing and throughput testing.
+ *
+ * Fights the player profile against every creature in enemy_creatureinfo.csv, --battles times
+ * each, through the same state machine as the game (with no view attached). The player always
+ * attacks. Battles are handed out to worker threads in chunks; each thread has its own combat
+ * generator and its own result tallies, so threads share nothing but the chunk counter. The
+ * generator is reseeded from --seed and the battle's index before every battle, so the results
+ * don't depend on which thread happened to claim which chunk.
+ */
+
+namespace {
+    struct SimOptions {
+        unsigned int battlesPerCreature = 1000;
+        unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+        unsigned int seed = 1;
+        unsigned long maxTurns = 1000;
+        std::string creaturePath = "entity-data/enemy_creatureinfo.csv";
+        std::string playerPath;
+    };
+
+    /// @brief Battles a worker claims at a time (keeps the shared counter off the hot path).
+    const unsigned int chunkSize = 64;
+
+    struct CreatureTally {
+        unsigned long wins = 0;
+        unsigned long losses = 0;
+        unsigned long timeouts = 0;
+        unsigned long turns = 0;
+    };
+
+    enum class Outcome { Win, Loss, Timeout };
+
+    // One battle from encounter to win, death or the turn limit
+    Outcome fight(GameStateMachine &game, GameSession &session, unsigned long maxTurns) {
+        game.dispatch(GameEvent::GoalReached, session);
+        game.dispatch(GameEvent::Confirm, session);
+        const unsigned long firstTurn = session.turns;
+        while (session.turns - firstTurn < maxTurns) {
+            game.dispatch(GameEvent::Attack, session);
+            game.dispatch(GameEvent::Confirm, session);
+            if (game.getState() == GameState::Play)
+                return Outcome::Win;
+            if (game.getState() == GameState::Over)
+                return Outcome::Loss;
+        }
+        return Outcome::Timeout;
+    }
+
+    void runWorker(const SimOptions &options, const entityInfo &playerInfo,
+                   const std::vector<entityInfo> &creatures, std::atomic<unsigned long> &nextBattle,
+                   std::vector<CreatureTally> &tallies) {
+        Metrics::ignoreThreadAllocations();
+
+        // Every creature is spawned once per thread and healed between battles, so a battle
+        // doesn't touch any strings
+        CombatRegistry combatants;
+        combatants.reserve(creatures.size() + 1);
+        GameSession session;
+        session.combatants = &combatants;
+        session.player = combatants.spawn(playerInfo, CombatSide::Player);
+        std::vector<CombatantId> roster;
+        roster.reserve(creatures.size());
+        for (const entityInfo &creature : creatures)
+            roster.push_back(combatants.spawn(creature, CombatSide::Enemy));
+        GameStateMachine game(gameStateTable(), GameState::Play);
+
+        const unsigned long totalBattles =
+            static_cast<unsigned long>(creatures.size()) * options.battlesPerCreature;
+        while (true) {
+            unsigned long first = nextBattle.fetch_add(chunkSize, std::memory_order_relaxed);
+            if (first >= totalBattles)
+                break;
+            unsigned long last = std::min(first + chunkSize, totalBattles);
+            for (unsigned long battle = first; battle < last; ++battle) {
+                size_t creatureIndex = battle / options.battlesPerCreature;
+                session.opponent = roster[creatureIndex];
+                for (CombatantId fighter : {session.player, session.opponent}) {
+                    Health &health = combatants.health.get(fighter);
+                    health.current = health.base;
+                    combatants.status.get(fighter).value = combatStatus::None;
+                }
+                seedCombatRandom(mixSeed(options.seed, battle));
+
+                unsigned long turnsBefore = session.turns;
+                CreatureTally &tally = tallies[creatureIndex];
+                switch (fight(game, session, options.maxTurns)) {
+                    case Outcome::Win:
+                        ++tally.wins;
+                        break;
+                    case Outcome::Loss:
+                        ++tally.losses;
+                        break;
+                    case Outcome::Timeout:
+                        ++tally.timeouts;
+                        break;
+                }
+                tally.turns += session.turns - turnsBefore;
+                // Losses and timeouts leave the machine mid-battle or on the game over screen
+                if (game.getState() != GameState::Play)
+                    game.reset(GameState::Play, session);
+            }
+        }
+    }
+
+    void printUsage() {
+        std::cout << "Usage: runner_sim [options]\n"
+                  << "  --battles <n>      battles against each creature (default 1000)\n"
+                  << "  --threads <n>      worker threads (default: one per core)\n"
+                  << "  --seed <n>         seed; the same seed gives the same results on any number\n"
+                  << "                     of threads (default 1)\n"
+                  << "  --max-turns <n>    turns before a battle counts as a timeout (default 1000)\n"
+                  << "  --creatures <csv>  creature list (default entity-data/enemy_creatureinfo.csv)\n"
+                  << "  --player <csv>     player profile, e.g. entity-data/playerinfo.csv\n"
+                  << "                     (default: the Runner's 100 health knight)" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    SimOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--battles") && i + 1 < argc)
+            options.battlesPerCreature = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            options.threads = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            options.seed = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--max-turns") && i + 1 < argc)
+            options.maxTurns = static_cast<unsigned long>(atol(argv[++i]));
+        else if (!strcmp(argv[i], "--creatures") && i + 1 < argc)
+            options.creaturePath = argv[++i];
+        else if (!strcmp(argv[i], "--player") && i + 1 < argc)
+            options.playerPath = argv[++i];
+        else {
+            printUsage();
+            return strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    const std::vector<entityInfo> creatures = loadEntityInfo(options.creaturePath);
+    if (creatures.empty()) {
+        std::cout << "No creatures loaded from " << options.creaturePath << std::endl;
+        return 1;
+    }
+    // Same player Engine creates, unless a saved profile is given
+    entityInfo playerInfo{"Player", "A lone knight.", 100, 0, 1};
+    if (!options.playerPath.empty()) {
+        std::vector<entityInfo> profiles = loadEntityInfo(options.playerPath);
+        if (profiles.empty()) {
+            std::cout << "No player profile in " << options.playerPath << std::endl;
+            return 1;
+        }
+        playerInfo = profiles.front();
+    }
+    if (options.battlesPerCreature == 0)
+        return 0;
+
+    // Per-thread tallies, merged after the join
+    std::vector<std::vector<CreatureTally>> threadTallies(
+        options.threads, std::vector<CreatureTally>(creatures.size()));
+    std::atomic<unsigned long> nextBattle{0};
+
+    using clock = std::chrono::steady_clock;
+    const clock::time_point start = clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < options.threads; ++t)
+        workers.emplace_back(runWorker, std::cref(options), std::cref(playerInfo),
+                             std::cref(creatures), std::ref(nextBattle),
+                             std::ref(threadTallies[t]));
+    for (std::thread &worker : workers)
+        worker.join();
+    const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    std::vector<CreatureTally> tallies(creatures.size());
+    for (const std::vector<CreatureTally> &perThread : threadTallies) {
+        for (size_t c = 0; c < creatures.size(); ++c) {
+            tallies[c].wins += perThread[c].wins;
+            tallies[c].losses += perThread[c].losses;
+            tallies[c].timeouts += perThread[c].timeouts;
+            tallies[c].turns += perThread[c].turns;
+        }
+    }
+
+    CreatureTally total;
+    std::printf("%s (%.0f health) vs %zu creatures, %u battles each\n\n", playerInfo.name.c_str(),
+                playerInfo.health, creatures.size(), options.battlesPerCreature);
+    std::printf("%-28s %8s %8s %8s %8s %10s\n", "Creature", "Health", "Win %", "Loss %",
+                "Timeout", "Avg turns");
+    for (size_t c = 0; c < creatures.size(); ++c) {
+        const CreatureTally &tally = tallies[c];
+        const double battles = options.battlesPerCreature;
+        std::printf("%-28.28s %8.0f %8.1f %8.1f %8lu %10.2f\n", creatures[c].name.c_str(),
+                    creatures[c].health, 100.0 * tally.wins / battles,
+                    100.0 * tally.losses / battles, tally.timeouts, tally.turns / battles);
+        total.wins += tally.wins;
+        total.losses += tally.losses;
+        total.timeouts += tally.timeouts;
+        total.turns += tally.turns;
+    }
+
+    const double battles = static_cast<double>(creatures.size()) * options.battlesPerCreature;
+    std::printf("\nOverall: %.1f%% wins, %.1f%% losses, %lu timeouts, %.2f turns per battle\n",
+                100.0 * total.wins / battles, 100.0 * total.losses / battles, total.timeouts,
+                total.turns / battles);
+    std::printf("%.0f battles in %.3f s on %u threads: %.0f battles/s, %.0f turns/s\n", battles,
+                seconds, options.threads, battles / seconds, total.turns / seconds);
+    return 0;
+}